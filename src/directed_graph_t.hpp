@@ -9,6 +9,7 @@
  *    been chosen to faciliate the portability of the code.
  *
  *  Compilation example: g++ -O3 my_code.cpp
+ *                       g++ -O3 -fopenmp my_code.cpp  (multithreaded version)
  *
  *  Author:  Antoine Allard
  *  WWW:     antoineallard.info
@@ -37,16 +38,58 @@
 // Standard Template Library
 #include <algorithm>
 #include <cmath>
+#include <cstdio>
 #include <cstdlib>
+#include <cstring>
+#include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <map>
+#include <new>
+#include <queue>
 #include <set>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
+// C standard library
+#include <stdint.h>
+// Conversion of floating-point numbers into text (C++17)
+#if __cplusplus >= 201703L && defined(__has_include)
+  #if __has_include(<charconv>)
+    #include <charconv>
+  #endif
+#endif
+// Threads (used to write files in the background when compiled with C++11 or later)
+#if __cplusplus >= 201103L
+  #include <thread>
+#endif
+// OpenMP (optional, enabled by compiling with -fopenmp). The directives are written
+//   PGL_OMP(...) such that they vanish, without warnings, when OpenMP is disabled.
+#ifdef _OPENMP
+  #include <omp.h>
+  #define PGL_PRAGMA(directive) _Pragma(#directive)
+  #define PGL_OMP(directive) PGL_PRAGMA(omp directive)
+#else
+  #define PGL_OMP(directive)
+#endif
+// SIMD intrinsics (the kernels are compiled for specific instruction sets and selected at runtime;
+//   define PGL_DISABLE_SIMD to only use the portable kernels)
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && !defined(PGL_DISABLE_SIMD)
+  #define PGL_HAS_X86_SIMD
+  #include <immintrin.h>
+#endif
+// POSIX (memory mapped files)
+#if defined(__unix__) || defined(__APPLE__)
+  #define PGL_HAS_MMAP
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
 
 
 
@@ -54,269 +97,4633 @@
 
 namespace pgl
 {
-  class directed_graph_t
+  template<typename EdgeOffset> class basic_directed_graph_t;
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Read-only view of the content of a file. The file is mapped in memory on POSIX systems and is
+  //   read into a buffer otherwise. Copies share the same mapping, which is released with the last
+  //   copy.
+  class mapped_file_t
   {
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Internal storage of the graph object.
-    public:
-      // Name to ID conversion. Every vertex is assigned a numerical ID in [0, |V|).
-      std::map<std::string, int> Name2ID;
-      // Edgelist.
-      std::set< std::pair<int, int> > edgelist;
-      // Adjacency list.
-      std::vector< std::vector< std::vector<int> > > adjacency_list;
-      // Indices for the in and out degree in the adjacency list.
-      static const int InDegreeIdx = 0;
-      static const int OutDegreeIdx = 1;
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Typedefs and accessors.
-    public:
-      typedef std::set< std::pair<int, int> >::iterator edgelist_iterator;
-      edgelist_iterator edgelist_begin() { return edgelist.begin(); }
-      edgelist_iterator edgelist_end()   { return edgelist.end();   }
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Objects/functions related to outputs.
-    public:
-      // Custom types to indicate how to identify vertices in outputs.
-      enum vID_t { vID_none, vID_num, vID_name };
-      static const bool header_true = true;
-      static const bool header_false = false;
-      // ID to name conversion.
-      std::vector< std::string > ID2Name;
-      // Build the ID2Name vector.
-      void build_ID2Name();
     private:
-      // Default width of columns.
-      static const int default_column_width = 15;
-      // Available vertex properties.
-      std::set< std::string > available_vertex_prop;
-      // Available vertex integer properties.
-      std::set< std::string > available_vertex_integer_prop;
-      // Headers associated with vertex properties.
-      std::map< std::string, std::string > v_prop_header;
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Properties.
+      struct mapping_t
+      {
+        const char* data;
+        std::size_t length;
+        bool is_mapped;
+        std::vector<char> buffer;
+        int nb_references;
+      };
+      mapping_t* mapping;
     public:
-      // Properties of the graph.
-      std::map< std::string, double> g_prop;
-      // Properties of vertices.
-      std::map< std::string, std::vector<double> > v_prop;
-    //   // Statistics of vertices.
-    //   std::map< std::string, std::map<int, double> > v_stat;
-      // List of all triangles.
-      std::vector< std::vector<int> > triangles;
-      // Triangle spectrum histogram.
-      std::map<std::string, int> triangle_spect;
+      mapped_file_t() : mapping(0) {}
+      mapped_file_t(const mapped_file_t& other) : mapping(other.mapping) { if(mapping != 0) { ++mapping->nb_references; } }
+      mapped_file_t& operator=(const mapped_file_t& other)
+      {
+        if(mapping != other.mapping)
+        {
+          close();
+          mapping = other.mapping;
+          if(mapping != 0)
+          {
+            ++mapping->nb_references;
+          }
+        }
+        return *this;
+      }
+      ~mapped_file_t() { close(); }
+      // Maps the file in memory (returns false if the file could not be opened). The access pattern
+      //   is a hint to the kernel (sequential reads or random accesses).
+      bool open(const std::string& filename, bool sequential_access = true);
+      // Releases the content of the file.
+      void close();
+      // Accessors.
+      const char* begin() const { return (mapping == 0) ? 0 : mapping->data; }
+      const char* end() const   { return begin() + size(); }
+      std::size_t size() const  { return (mapping == 0) ? 0 : mapping->length; }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Array whose elements are either owned (std::vector) or borrowed from memory owned elsewhere
+  //   (e.g., a mapped binary snapshot). Borrowed elements are copied the first time the array is
+  //   modified through owned().
+  template<typename T>
+  class array_t
+  {
     private:
-      // Function verifying whether a vertex property exists.
-      void is_vertex_property(std::string prop);
-      // Function verifying wether a vertex property qualifies as a "integer" property.
-      bool is_vertex_integer_property(std::string prop, bool exit_on_error);
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Functions loading/saving edgelists and vertices/edges properties.
+      std::vector<T> elements;
+      const T* borrowed;
+      std::size_t nb_borrowed;
     public:
-      // Functions to add vertices and/or edges.
-      int add_vertex(std::string name_str, bool ignore_unknown_vertices = false);
-      bool add_edge(std::string name1_str, std::string name2_str, bool ignore_unknown_vertices = false);
-      bool add_edge(int v1, int v2);
+      array_t() : borrowed(0), nb_borrowed(0) {}
+      std::size_t size() const { return (borrowed != 0) ? nb_borrowed : elements.size(); }
+      bool empty() const { return size() == 0; }
+      const T* data() const { return (borrowed != 0) ? borrowed : (elements.empty() ? 0 : &elements[0]); }
+      const T* begin() const { return data(); }
+      const T* end() const { return data() + size(); }
+      const T& operator[](std::size_t i) const { return data()[i]; }
+      // Elements for modification.
+      std::vector<T>& owned()
+      {
+        if(borrowed != 0)
+        {
+          elements.assign(borrowed, borrowed + nb_borrowed);
+          borrowed = 0;
+          nb_borrowed = 0;
+        }
+        return elements;
+      }
+      // Uses n elements owned elsewhere.
+      void borrow(const T* first, std::size_t n) { std::vector<T>().swap(elements); borrowed = (n == 0) ? 0 : first; nb_borrowed = n; }
+      void clear() { std::vector<T>().swap(elements); borrowed = 0; nb_borrowed = 0; }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Allocator returning memory aligned on 64 bytes (i.e., on cache lines and on the width of the
+  //   widest SIMD registers).
+  template<typename T>
+  class aligned_allocator_t
+  {
     public:
-      // Loads the graph structure from an edgelist in a file.
-      void load_graph_from_edgelist_file(std::string edgelist_filename);
-      // Outputing the vertices properties (the last 3 inputs can be omitted and/or put in any order).
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID = vID_name, int width = default_column_width, bool header = header_true);
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID,            bool header,                      int width = default_column_width)                { save_vertices_properties(filename, props_id, vID, width, header); };
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, bool header,          vID_t vID = vID_name,             int width = default_column_width)                { save_vertices_properties(filename, props_id, vID, width, header); };
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, bool header,          int width,                        vID_t vID = vID_name)                            { save_vertices_properties(filename, props_id, vID, width, header); };
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, int width,            vID_t vID = vID_name,             bool header = header_true)                       { save_vertices_properties(filename, props_id, vID, width, header); };
-      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, int width,            bool header,                      vID_t vID = vID_name)                            { save_vertices_properties(filename, props_id, vID, width, header); };
-      // Loads vertices properties from a file.
-      void load_vertices_properties(std::string prop_filename, int usecol, std::string prop, std::string prop_header = "", bool ignore_unknown_vertices = true);
-      // Adding new vertex (integer) properties.
-      void add_new_vertex_integer_property(std::string prop, std::string prop_header = "");
-      void add_new_vertex_property(std::string prop, std::string prop_header = "");
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Functions building secondary objects related to the graph.
+      typedef T value_type;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+      template<typename U> struct rebind { typedef aligned_allocator_t<U> other; };
+      static const std::size_t alignment = 64;
+      aligned_allocator_t() {}
+      template<typename U> aligned_allocator_t(const aligned_allocator_t<U>&) {}
+      pointer address(reference x) const { return &x; }
+      const_pointer address(const_reference x) const { return &x; }
+      size_type max_size() const { return (std::numeric_limits<size_type>::max() - alignment - sizeof(void*)) / sizeof(T); }
+      void construct(pointer p, const T& value) { new(static_cast<void*>(p)) T(value); }
+      void destroy(pointer p) { p->~T(); }
+      // Over-allocates and keeps the address of the raw block just before the aligned one.
+      pointer allocate(size_type n, const void* = 0)
+      {
+        char* raw = static_cast<char*>(::operator new(n * sizeof(T) + alignment + sizeof(void*)));
+        std::size_t address = reinterpret_cast<std::size_t>(raw + sizeof(void*));
+        char* aligned = raw + sizeof(void*) + (alignment - address % alignment) % alignment;
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<pointer>(aligned);
+      }
+      void deallocate(pointer p, size_type) { ::operator delete(reinterpret_cast<void**>(p)[-1]); }
+      template<typename U> bool operator==(const aligned_allocator_t<U>&) const { return true; }
+      template<typename U> bool operator!=(const aligned_allocator_t<U>&) const { return false; }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Types of the values stored in the columns of vertex properties.
+  enum column_type_t { column_int32, column_int64, column_float, column_double };
+  template<typename T> struct column_type_of;
+  template<> struct column_type_of<int32_t> { static const column_type_t value = column_int32;  };
+  template<> struct column_type_of<int64_t> { static const column_type_t value = column_int64;  };
+  template<> struct column_type_of<float>   { static const column_type_t value = column_float;  };
+  template<> struct column_type_of<double>  { static const column_type_t value = column_double; };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Values of a vertex property, stored contiguously with their own type. Values can be read and
+  //   written as doubles via operator[] (like the std::vector<double> previously used), while loops
+  //   should rather use the typed pointer given by data<T>().
+  class vertex_column_t
+  {
+    private:
+      column_type_t column_type;
+      std::vector<unsigned char, aligned_allocator_t<unsigned char> > bytes;
+      template<typename T>
+      void check_type() const
+      {
+        if(column_type_of<T>::value != column_type)
+        {
+          std::cerr << "ERROR: Wrong type used to access the values of a vertex property." << std::endl;
+          std::terminate();
+        }
+      }
+      template<typename T>
+      static double sum_of_values(const T* values, std::size_t nb_values)
+      {
+        double sum = 0;
+        for(std::size_t i(0); i<nb_values; ++i)
+        {
+          sum += values[i];
+        }
+        return sum;
+      }
     public:
-      // Builds the adjacency list.
-      void build_adjacency_list();
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Functions extracting properties of graph/vertices/edges.
+      // Reference to a value, converted from/to double.
+      class reference_t
+      {
+        private:
+          vertex_column_t* column;
+          std::size_t i;
+        public:
+          reference_t(vertex_column_t* c, std::size_t idx) : column(c), i(idx) {}
+          operator double() const { return column->get(i); }
+          reference_t& operator=(double value) { column->set(i, value); return *this; }
+          reference_t& operator=(const reference_t& other) { column->set(i, other); return *this; }
+          reference_t& operator+=(double value) { column->set(i, column->get(i) + value); return *this; }
+          reference_t& operator-=(double value) { column->set(i, column->get(i) - value); return *this; }
+          reference_t& operator*=(double value) { column->set(i, column->get(i) * value); return *this; }
+          reference_t& operator/=(double value) { column->set(i, column->get(i) / value); return *this; }
+      };
+      explicit vertex_column_t(column_type_t type = column_double) : column_type(type) {}
+      static std::size_t value_size(column_type_t type) { return (type == column_int32 || type == column_float) ? 4 : 8; }
+      column_type_t type() const { return column_type; }
+      std::size_t size() const { return bytes.size() / value_size(column_type); }
+      bool empty() const { return bytes.empty(); }
+      // Typed access to the values (terminates if T is not the type of the column).
+      template<typename T> T* data() { check_type<T>(); return reinterpret_cast<T*>(bytes.empty() ? 0 : &bytes[0]); }
+      template<typename T> const T* data() const { check_type<T>(); return reinterpret_cast<const T*>(bytes.empty() ? 0 : &bytes[0]); }
+      double get(std::size_t i) const
+      {
+        const unsigned char* values = &bytes[0];
+        switch(column_type)
+        {
+          case column_int32: return reinterpret_cast<const int32_t*>(values)[i];
+          case column_int64: return reinterpret_cast<const int64_t*>(values)[i];
+          case column_float: return reinterpret_cast<const float*>(values)[i];
+          default:           return reinterpret_cast<const double*>(values)[i];
+        }
+      }
+      void set(std::size_t i, double value)
+      {
+        unsigned char* values = &bytes[0];
+        switch(column_type)
+        {
+          case column_int32: reinterpret_cast<int32_t*>(values)[i] = static_cast<int32_t>(value); break;
+          case column_int64: reinterpret_cast<int64_t*>(values)[i] = static_cast<int64_t>(value); break;
+          case column_float: reinterpret_cast<float*>(values)[i] = static_cast<float>(value);     break;
+          default:           reinterpret_cast<double*>(values)[i] = value;                         break;
+        }
+      }
+      reference_t operator[](std::size_t i) { return reference_t(this, i); }
+      double operator[](std::size_t i) const { return get(i); }
+      void resize(std::size_t n, double value = 0)
+      {
+        std::size_t old_size = size();
+        bytes.resize(n * value_size(column_type));
+        for(std::size_t i(old_size); i<n; ++i)
+        {
+          set(i, value);
+        }
+      }
+      void push_back(double value) { resize(size() + 1, value); }
+      void clear() { std::vector<unsigned char, aligned_allocator_t<unsigned char> >().swap(bytes); }
+      // Changes the type of the values (values are converted as by a static_cast).
+      void convert(column_type_t type)
+      {
+        vertex_column_t converted(type);
+        converted.bytes.resize(size() * value_size(type));
+        for(std::size_t i(0), ii(size()); i<ii; ++i)
+        {
+          converted.set(i, get(i));
+        }
+        bytes.swap(converted.bytes);
+        column_type = type;
+      }
+      // Reorders the values, the i-th value becoming the one of index order[i] (missing values are
+      //   taken as 0).
+      void permute(const std::vector<int>& order)
+      {
+        if(size() < order.size())
+        {
+          resize(order.size());
+        }
+        std::size_t width = value_size(column_type);
+        std::vector<unsigned char, aligned_allocator_t<unsigned char> > permuted(order.size() * width);
+        for(std::size_t i(0), ii(order.size()); i<ii; ++i)
+        {
+          std::memcpy(&permuted[i * width], &bytes[order[i] * width], width);
+        }
+        bytes.swap(permuted);
+      }
+      // Sum of the values (accumulated as doubles in the order of the vertices).
+      double sum() const
+      {
+        switch(column_type)
+        {
+          case column_int32: return sum_of_values(data<int32_t>(), size());
+          case column_int64: return sum_of_values(data<int64_t>(), size());
+          case column_float: return sum_of_values(data<float>(), size());
+          default:           return sum_of_values(data<double>(), size());
+        }
+      }
+      // Copy of the values as doubles.
+      std::vector<double> values() const
+      {
+        std::vector<double> copy(size());
+        for(std::size_t i(0), ii(size()); i<ii; ++i)
+        {
+          copy[i] = get(i);
+        }
+        return copy;
+      }
+  };
+
+
+  // Statistics of a graph stored with their own type (counts are integers). A bitmask records which
+  //   statistics are up to date. Statistics that have never been computed keep their initial values
+  //   (-1 for the ones that cannot be negative, as was previously done with g_prop).
+  struct graph_stats_t
+  {
+    // Identifiers of the statistics.
+    enum stat_t { stat_nb_vertices, stat_nb_edges, stat_density, stat_nb_reciprocal_edges,
+                  stat_reciprocity_ratio, stat_reciprocity_stat, stat_nb_triangles,
+                  stat_total_nb_triads, stat_undir_global_clust, stat_nb_vertices_undir_deg_0,
+                  stat_nb_vertices_undir_deg_1, nb_stats };
+    int64_t nb_vertices;
+    int64_t nb_edges;
+    double density;
+    int64_t nb_reciprocal_edges;
+    double reciprocity_ratio;
+    double reciprocity_stat;
+    int64_t nb_triangles;
+    int64_t total_nb_triads;
+    double undir_global_clust;
+    int64_t nb_vertices_undir_deg_0;
+    int64_t nb_vertices_undir_deg_1;
+    // Statistics that are up to date (one bit per statistic).
+    uint32_t valid;
+    // Statistics that have been estimated from a sample (one bit per statistic), with the bounds of
+    //   their 95% confidence intervals.
+    uint32_t estimated;
+    double lower_bound[nb_stats];
+    double upper_bound[nb_stats];
+    graph_stats_t()
+      : nb_vertices(0), nb_edges(0), density(0), nb_reciprocal_edges(-1), reciprocity_ratio(-1),
+        reciprocity_stat(-1), nb_triangles(-1), total_nb_triads(0), undir_global_clust(0),
+        nb_vertices_undir_deg_0(0), nb_vertices_undir_deg_1(0),
+        valid((1u << stat_nb_vertices) | (1u << stat_nb_edges) | (1u << stat_density)), estimated(0)
+    {
+      std::fill(lower_bound, lower_bound + nb_stats, 0);
+      std::fill(upper_bound, upper_bound + nb_stats, 0);
+    }
+    bool is_valid(stat_t stat) const { return (valid >> stat) & 1u; }
+    bool is_estimate(stat_t stat) const { return (estimated >> stat) & 1u; }
+    // Marks a statistic as up to date (and as exact).
+    void validate(stat_t stat) { valid |= 1u << stat; estimated &= ~(1u << stat); }
+    // Marks a statistic as an estimate lying within the given confidence interval.
+    void set_estimate(stat_t stat, double lower, double upper)
+    {
+      estimated |= 1u << stat;
+      lower_bound[stat] = lower;
+      upper_bound[stat] = upper;
+    }
+    // Marks every statistic depending on the edges as outdated (their values are kept).
+    void invalidate_edge_statistics() { valid &= (1u << stat_nb_vertices) | (1u << stat_nb_edges); }
+    // Names of the statistics (keywords of g_prop).
+    static const char* name(int stat)
+    {
+      static const char* names[nb_stats] = { "nb_vertices", "nb_edges", "density", "nb_reciprocal_edges",
+                                             "reciprocity_ratio", "reciprocity_stat", "nb_triangles",
+                                             "total_nb_triads", "undir_global_clust", "nb_vertices_undir_deg_0",
+                                             "nb_vertices_undir_deg_1" };
+      return names[stat];
+    }
+    // Identifier of a statistic given its name (-1 if the name is not a statistic).
+    static int find_stat(const std::string& stat_name)
+    {
+      for(int stat(0); stat<nb_stats; ++stat)
+      {
+        if(stat_name == name(stat))
+        {
+          return stat;
+        }
+      }
+      return -1;
+    }
+    double get(int stat) const
+    {
+      switch(stat)
+      {
+        case stat_nb_vertices:             return nb_vertices;
+        case stat_nb_edges:                return nb_edges;
+        case stat_density:                 return density;
+        case stat_nb_reciprocal_edges:     return nb_reciprocal_edges;
+        case stat_reciprocity_ratio:       return reciprocity_ratio;
+        case stat_reciprocity_stat:        return reciprocity_stat;
+        case stat_nb_triangles:            return nb_triangles;
+        case stat_total_nb_triads:         return total_nb_triads;
+        case stat_undir_global_clust:      return undir_global_clust;
+        case stat_nb_vertices_undir_deg_0: return nb_vertices_undir_deg_0;
+        default:                           return nb_vertices_undir_deg_1;
+      }
+    }
+    void set(int stat, double value)
+    {
+      switch(stat)
+      {
+        case stat_nb_vertices:             nb_vertices = static_cast<int64_t>(value);             break;
+        case stat_nb_edges:                nb_edges = static_cast<int64_t>(value);                break;
+        case stat_density:                 density = value;                                       break;
+        case stat_nb_reciprocal_edges:     nb_reciprocal_edges = static_cast<int64_t>(value);     break;
+        case stat_reciprocity_ratio:       reciprocity_ratio = value;                             break;
+        case stat_reciprocity_stat:        reciprocity_stat = value;                              break;
+        case stat_nb_triangles:            nb_triangles = static_cast<int64_t>(value);            break;
+        case stat_total_nb_triads:         total_nb_triads = static_cast<int64_t>(value);         break;
+        case stat_undir_global_clust:      undir_global_clust = value;                            break;
+        case stat_nb_vertices_undir_deg_0: nb_vertices_undir_deg_0 = static_cast<int64_t>(value); break;
+        default:                           nb_vertices_undir_deg_1 = static_cast<int64_t>(value); break;
+      }
+      validate(static_cast<stat_t>(stat));
+    }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Properties of a graph accessible by their name (e.g., g_prop["nb_edges"]). The statistics of
+  //   graph_stats_t are read/written in their typed fields (which should be used directly in loops),
+  //   while other properties (e.g., averages of vertex properties) are kept in a map.
+  class graph_properties_t : public graph_stats_t
+  {
     private:
-      // Function checking if directed edge already exists.
-      bool is_edge(int v_source, int v_target);
+      std::map<std::string, double> other_properties;
     public:
-      // Computes the average value of a vertex property.
-      void compute_average_vertex_prop(std::string prop);
-      // Extracts the in-/out-degree of vertices.
-      void compute_degrees();
-      // Computes the density of the graph.
-      void compute_density();
-      // Computes the reciprocity.
-      void compute_reciprocity();
-      // Compiles a list of all triangles in the graph.
-      void survey_triangles(bool build_triangle_list = true, bool compute_undirected_local_clustering = true);
-      // Compiles the number of every unique triangle configurations.
-      void compile_triangle_spectrum();
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-    // Constructors (and related functions).
+      // Reference to a property, converted from/to double.
+      class reference_t
+      {
+        private:
+          graph_stats_t* stats;
+          int stat;
+          double* other;
+        public:
+          reference_t(graph_stats_t* s, int st, double* o) : stats(s), stat(st), other(o) {}
+          operator double() const { return (other != 0) ? *other : stats->get(stat); }
+          reference_t& operator=(double value)
+          {
+            if(other != 0)
+            {
+              *other = value;
+            }
+            else
+            {
+              stats->set(stat, value);
+            }
+            return *this;
+          }
+          reference_t& operator=(const reference_t& value) { return *this = static_cast<double>(value); }
+          reference_t& operator+=(double value) { return *this = static_cast<double>(*this) + value; }
+          reference_t& operator-=(double value) { return *this = static_cast<double>(*this) - value; }
+      };
+      reference_t operator[](const std::string& prop)
+      {
+        int stat = find_stat(prop);
+        return (stat == -1) ? reference_t(this, -1, &other_properties[prop]) : reference_t(this, stat, 0);
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Columns of the vertex properties. Each property is identified by a handle (its index) which can
+  //   be resolved once to avoid looking up its name repeatedly. Columns are stored in a deque such
+  //   that references to them remain valid when other properties are added.
+  class vertex_property_store_t
+  {
     private:
-      // Function setting default values (to avoid requiring the C++11 standard).
-      void initialization();
+      std::deque<vertex_column_t> columns;
+      std::map<std::string, int> handles;
     public:
-      // Empty constructor.
-      directed_graph_t() { initialization(); };
-      // Constructor with edgelist.
-      directed_graph_t(std::string edgelist_filename) { initialization(); load_graph_from_edgelist_file(edgelist_filename); };
-      // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-      // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-      // // Convert to python.
-      // public:
-      //   // Graph properties.
-      //   int get_nb_vertices();
-      //   int get_nb_edges();
-      //   int get_nb_reciprocal_edges();
-      //   double get_reciprocity();
-      //   // // Vertex properties.
-      //   // std::map<std::string, double> get_local_reciprocity();
+      // Handle of a property (an empty column of doubles is added if the property does not exist).
+      int handle(const std::string& prop)
+      {
+        std::map<std::string, int>::iterator it = handles.find(prop);
+        if(it != handles.end())
+        {
+          return it->second;
+        }
+        columns.push_back(vertex_column_t());
+        handles[prop] = columns.size() - 1;
+        return columns.size() - 1;
+      }
+      // Handle of a property (-1 if the property does not exist).
+      int find(const std::string& prop) const
+      {
+        std::map<std::string, int>::const_iterator it = handles.find(prop);
+        return (it != handles.end()) ? it->second : -1;
+      }
+      bool contains(const std::string& prop) const { return find(prop) != -1; }
+      int size() const { return columns.size(); }
+      vertex_column_t& operator[](int h) { return columns[h]; }
+      const vertex_column_t& operator[](int h) const { return columns[h]; }
+      vertex_column_t& operator[](const std::string& prop) { return columns[handle(prop)]; }
+      // Replaces the column of a property by an empty column of the given type.
+      vertex_column_t& create(const std::string& prop, column_type_t type)
+      {
+        vertex_column_t& column = columns[handle(prop)];
+        column = vertex_column_t(type);
+        return column;
+      }
+      // Reorders the values of every property that has been computed (see vertex_column_t::permute).
+      void permute(const std::vector<int>& order)
+      {
+        for(int h(0), hh(columns.size()); h<hh; ++h)
+        {
+          if(!columns[h].empty())
+          {
+            columns[h].permute(order);
+          }
+        }
+      }
   };
-}
 
 
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Tokenizer working in place over a buffer of text. Tokens are separated by white spaces (as
+  //   defined by std::isspace) and are returned as a pointer/length pair into the buffer.
+  class text_scanner_t
+  {
+    private:
+      const char* next;
+      const char* last;
+      const char* pos;
+      const char* line_end;
+    public:
+      text_scanner_t(const char* first, const char* end) : next(first), last(end), pos(first), line_end(first) {}
+      // White spaces.
+      static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f'; }
+      // Moves to the beginning of the next line (returns false once the buffer has been consumed).
+      bool next_line()
+      {
+        if(next >= last)
+        {
+          return false;
+        }
+        pos = next;
+        line_end = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+        if(line_end == 0)
+        {
+          line_end = last;
+        }
+        next = line_end + 1;
+        return true;
+      }
+      // Extracts the next token of the current line (returns false if there is none left).
+      bool next_token(const char*& token, int& token_length)
+      {
+        while(pos < line_end && is_space(*pos))
+        {
+          ++pos;
+        }
+        if(pos == line_end)
+        {
+          return false;
+        }
+        token = pos;
+        while(pos < line_end && !is_space(*pos))
+        {
+          ++pos;
+        }
+        token_length = pos - token;
+        return true;
+      }
+  };
 
 
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Extracts the names of the vertices of the edge on the current line of an edgelist (returns false
+  //   for empty lines, lines of comment, lines with a single name and self-loops).
+  inline bool scan_edge(text_scanner_t& scanner, const char*& name1, int& length1, const char*& name2, int& length2)
+  {
+    if( !scanner.next_token(name1, length1) || name1[0] == '#' || !scanner.next_token(name2, length2) )
+    {
+      return false;
+    }
+    return length1 != length2 || std::memcmp(name1, name2, length1) != 0;
+  }
 
 
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Number of threads available to parallel regions (1 if compiled without OpenMP).
+  inline int max_nb_threads()
+  {
+  #ifdef _OPENMP
+    return omp_get_max_threads();
+  #else
+    return 1;
+  #endif
+  }
 
 
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Index of the calling thread within the current parallel region (0 if compiled without OpenMP).
+  inline int thread_num()
+  {
+  #ifdef _OPENMP
+    return omp_get_thread_num();
+  #else
+    return 0;
+  #endif
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Sorts a vector using all available threads (contiguous blocks are sorted in parallel and then
+  //   merged pairwise).
+  template<typename T>
+  void parallel_sort(std::vector<T>& v)
+  {
+    int nb_blocks = std::max(1, std::min<int>(max_nb_threads(), v.size() / (1 << 16)));
+    std::vector<std::size_t> bounds(nb_blocks + 1);
+    for(int b(0); b<=nb_blocks; ++b)
+    {
+      bounds[b] = (v.size() / nb_blocks) * b + std::min<std::size_t>(b, v.size() % nb_blocks);
+    }
+    PGL_OMP(parallel for schedule(static, 1))
+    for(int b = 0; b < nb_blocks; ++b)
+    {
+      std::sort(v.begin() + bounds[b], v.begin() + bounds[b + 1]);
+    }
+    for(int width(1); width<nb_blocks; width*=2)
+    {
+      PGL_OMP(parallel for schedule(static, 1))
+      for(int b = 0; b < nb_blocks - width; b += 2 * width)
+      {
+        std::inplace_merge(v.begin() + bounds[b], v.begin() + bounds[b + width], v.begin() + bounds[std::min(b + 2 * width, nb_blocks)]);
+      }
+    }
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Kernels intersecting two sorted arrays without duplicates. The common elements are written in
+  //   increasing order into out (if Store is true), which must be able to hold min(na, nb)
+  //   elements. They return the number of common elements.
+  template<bool Store>
+  int intersect_sorted_scalar(const int* a, int na, const int* b, int nb, int* out)
+  {
+    int i = 0, j = 0, nb_common = 0;
+    while(i < na && j < nb)
+    {
+      if(a[i] < b[j])
+      {
+        ++i;
+      }
+      else if(b[j] < a[i])
+      {
+        ++j;
+      }
+      else
+      {
+        if(Store) { out[nb_common] = a[i]; }
+        ++nb_common;
+        ++i;
+        ++j;
+      }
+    }
+    return nb_common;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Galloping search through the largest array (efficient when the sizes are very different).
+  template<bool Store>
+  int intersect_sorted_galloping(const int* a, int na, const int* b, int nb, int* out)
+  {
+    if(na > nb)
+    {
+      std::swap(a, b);
+      std::swap(na, nb);
+    }
+    int nb_common = 0;
+    const int* first = b;
+    const int* last = b + nb;
+    for(int i(0); i<na && first!=last; ++i)
+    {
+      int step = 1;
+      const int* bound = first;
+      while(bound < last && *bound < a[i])
+      {
+        first = bound + 1;
+        bound = (last - bound > step) ? bound + step : last;
+        step *= 2;
+      }
+      first = std::lower_bound(first, bound, a[i]);
+      if(first != last && *first == a[i])
+      {
+        if(Store) { out[nb_common] = a[i]; }
+        ++nb_common;
+        ++first;
+      }
+    }
+    return nb_common;
+  }
+
+
+#ifdef PGL_HAS_X86_SIMD
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Block-wise kernels: blocks of W elements of both arrays are compared all-against-all and the
+  //   block with the smallest last element is then replaced by the next one. The SSE kernel
+  //   compares the block of a with every rotation of the block of b, while the AVX2 and AVX-512
+  //   kernels compare it with every element of the block of b broadcast to all lanes. The
+  //   remaining elements are merged by the scalar kernel.
+  template<bool Store>
+  __attribute__((target("sse4.2")))
+  int intersect_sorted_sse(const int* a, int na, const int* b, int nb, int* out)
+  {
+    int i = 0, j = 0, nb_common = 0;
+    while(i + 4 <= na && j + 4 <= nb)
+    {
+      __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+      __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+      __m128i eq = _mm_cmpeq_epi32(va, vb);
+      eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+      eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+      eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+      unsigned int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+      if(Store)
+      {
+        for(; mask != 0; mask &= mask - 1)
+        {
+          out[nb_common++] = a[i + __builtin_ctz(mask)];
+        }
+      }
+      else
+      {
+        nb_common += __builtin_popcount(mask);
+      }
+      int a_max = a[i + 3], b_max = b[j + 3];
+      i += (a_max <= b_max) ? 4 : 0;
+      j += (b_max <= a_max) ? 4 : 0;
+    }
+    return nb_common + intersect_sorted_scalar<Store>(a + i, na - i, b + j, nb - j, Store ? out + nb_common : out);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  template<bool Store>
+  __attribute__((target("avx2")))
+  int intersect_sorted_avx2(const int* a, int na, const int* b, int nb, int* out)
+  {
+    int i = 0, j = 0, nb_common = 0;
+    while(i + 8 <= na && j + 8 <= nb)
+    {
+      __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      __m256i eq = _mm256_setzero_si256();
+      for(int r(0); r<8; ++r)
+      {
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, _mm256_set1_epi32(b[j + r])));
+      }
+      unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(eq));
+      if(Store)
+      {
+        for(; mask != 0; mask &= mask - 1)
+        {
+          out[nb_common++] = a[i + __builtin_ctz(mask)];
+        }
+      }
+      else
+      {
+        nb_common += __builtin_popcount(mask);
+      }
+      int a_max = a[i + 7], b_max = b[j + 7];
+      i += (a_max <= b_max) ? 8 : 0;
+      j += (b_max <= a_max) ? 8 : 0;
+    }
+    return nb_common + intersect_sorted_scalar<Store>(a + i, na - i, b + j, nb - j, Store ? out + nb_common : out);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  template<bool Store>
+  __attribute__((target("avx512f")))
+  int intersect_sorted_avx512(const int* a, int na, const int* b, int nb, int* out)
+  {
+    int i = 0, j = 0, nb_common = 0;
+    while(i + 16 <= na && j + 16 <= nb)
+    {
+      __m512i va = _mm512_loadu_si512(a + i);
+      __mmask16 eq = 0;
+      for(int r(0); r<16; ++r)
+      {
+        eq = eq | _mm512_cmpeq_epi32_mask(va, _mm512_set1_epi32(b[j + r]));
+      }
+      unsigned int mask = eq;
+      if(Store)
+      {
+        for(; mask != 0; mask &= mask - 1)
+        {
+          out[nb_common++] = a[i + __builtin_ctz(mask)];
+        }
+      }
+      else
+      {
+        nb_common += __builtin_popcount(mask);
+      }
+      int a_max = a[i + 15], b_max = b[j + 15];
+      i += (a_max <= b_max) ? 16 : 0;
+      j += (b_max <= a_max) ? 16 : 0;
+    }
+    return nb_common + intersect_sorted_scalar<Store>(a + i, na - i, b + j, nb - j, Store ? out + nb_common : out);
+  }
+#endif
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Set of kernels compiled for one instruction set.
+  struct intersection_kernel_t
+  {
+    typedef int (*function_t)(const int* a, int na, const int* b, int nb, int* out);
+    const char* name;
+    // Writes the common elements.
+    function_t intersect;
+    // Only counts the common elements (out is ignored).
+    function_t count;
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Kernels supported by the processor, from the most portable to the fastest.
+  inline std::vector<intersection_kernel_t> available_intersection_kernels()
+  {
+    std::vector<intersection_kernel_t> kernels;
+    intersection_kernel_t scalar = { "scalar", &intersect_sorted_scalar<true>, &intersect_sorted_scalar<false> };
+    kernels.push_back(scalar);
+  #ifdef PGL_HAS_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("sse4.2"))
+    {
+      intersection_kernel_t sse = { "sse4.2", &intersect_sorted_sse<true>, &intersect_sorted_sse<false> };
+      kernels.push_back(sse);
+    }
+    if(__builtin_cpu_supports("avx2"))
+    {
+      intersection_kernel_t avx2 = { "avx2", &intersect_sorted_avx2<true>, &intersect_sorted_avx2<false> };
+      kernels.push_back(avx2);
+    }
+    if(__builtin_cpu_supports("avx512f"))
+    {
+      intersection_kernel_t avx512 = { "avx512", &intersect_sorted_avx512<true>, &intersect_sorted_avx512<false> };
+      kernels.push_back(avx512);
+    }
+  #endif
+    return kernels;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Fastest kernels supported by the processor (selected once).
+  inline const intersection_kernel_t& best_intersection_kernel()
+  {
+    static const intersection_kernel_t kernel = available_intersection_kernels().back();
+    return kernel;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Intersection of two sorted arrays without duplicates (the common elements are written in
+  //   increasing order into out, which must be able to hold min(na, nb) elements). Returns the
+  //   number of common elements. Arrays of very different sizes are intersected by galloping
+  //   through the largest one, and by the fastest block-wise kernel otherwise.
+  inline int intersect_sorted(const int* a, int na, const int* b, int nb, int* out)
+  {
+    if(std::min(na, nb) == 0)
+    {
+      return 0;
+    }
+    if(std::max(na, nb) / std::min(na, nb) >= 32)
+    {
+      return intersect_sorted_galloping<true>(a, na, b, nb, out);
+    }
+    return best_intersection_kernel().intersect(a, na, b, nb, out);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Number of common elements of two sorted arrays without duplicates.
+  inline int intersection_size(const int* a, int na, const int* b, int nb)
+  {
+    if(std::min(na, nb) == 0)
+    {
+      return 0;
+    }
+    if(std::max(na, nb) / std::min(na, nb) >= 32)
+    {
+      return intersect_sorted_galloping<false>(a, na, b, nb, NULL);
+    }
+    return best_intersection_kernel().count(a, na, b, nb, NULL);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Size of the union of two sorted arrays without duplicates.
+  inline int union_size(const int* a, int na, const int* b, int nb)
+  {
+    int i = 0, j = 0, nb_common = 0;
+    while(i < na && j < nb)
+    {
+      if(a[i] < b[j])       { ++i; }
+      else if(b[j] < a[i])  { ++j; }
+      else                  { ++i; ++j; ++nb_common; }
+    }
+    return na + nb - nb_common;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Appends an integer encoded as a varint (7 bits per byte, least significant bits first, the
+  //   highest bit of a byte being set when more bytes follow).
+  inline void append_varint(std::vector<unsigned char>& bytes, uint32_t value)
+  {
+    while(value >= 0x80)
+    {
+      bytes.push_back(static_cast<unsigned char>(value | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(value));
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Reads a varint and moves the position past it.
+  inline uint32_t read_varint(const unsigned char*& position)
+  {
+    uint32_t value = *position & 0x7F;
+    for(int shift(7); *position++ & 0x80; shift += 7)
+    {
+      value |= static_cast<uint32_t>(*position & 0x7F) << shift;
+    }
+    return value;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Appends a sorted array of distinct non-negative integers encoded as varints: the number of
+  //   elements followed by the gaps between consecutive elements minus one (the first element is
+  //   its own gap). Most gaps between neighbours fit in one or two bytes.
+  inline void compress_sorted(const int* a, int na, std::vector<unsigned char>& bytes)
+  {
+    append_varint(bytes, na);
+    for(int i(0), previous(-1); i<na; previous = a[i++])
+    {
+      append_varint(bytes, a[i] - previous - 1);
+    }
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Sorted array encoded by compress_sorted, decoded one element at a time.
+  class compressed_sorted_t
+  {
+    private:
+      const unsigned char* position;
+      int nb_elements;
+      int nb_remaining;
+      int current;
+    public:
+      compressed_sorted_t(const unsigned char* bytes) : position(bytes), current(-1) { nb_elements = nb_remaining = read_varint(position); }
+      int size() const { return nb_elements; }
+      // Decodes the next element (returns false once all elements have been decoded).
+      bool next(int& element)
+      {
+        if(nb_remaining == 0)
+        {
+          return false;
+        }
+        --nb_remaining;
+        current += read_varint(position) + 1;
+        element = current;
+        return true;
+      }
+      // Decodes the remaining elements into an array (returns their number).
+      int decode(int* out)
+      {
+        int n = nb_remaining;
+        for(int i(0); i<n; ++i)
+        {
+          current += read_varint(position) + 1;
+          out[i] = current;
+        }
+        nb_remaining = 0;
+        return n;
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Directions of the edges between a vertex and one of its undirected neighbours (combined as
+  //   bits, 3 means that the edge is reciprocal).
+  enum edge_direction_t { edge_to_neighbour = 1, edge_from_neighbour = 2 };
+  // Directions seen from the neighbour.
+  inline int reverse_directions(int directions)
+  {
+    return ((directions & edge_to_neighbour) << 1) | ((directions & edge_from_neighbour) >> 1);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Unique configurations of triangles (the 20 other possible triangles are automorphisms of these 7
+  //   configurations).
+  //   0 "3cycle":   A  -> B  -> C  -> A
+  //   1 "3nocycle": A  -> B  -> C <-  A
+  //   2 "4cycle":   A <-> B  -> C  -> A
+  //   3 "4outward": A <-> B  -> C <-  A
+  //   4 "4inward":  A <-> B <-  C  -> A
+  //   5 "5cycle":   A <-> B <-> C  -> A
+  //   6 "6cycle":   A <-> B <-> C <-> A
+  const int nb_triangle_configurations = 7;
+  inline const char* triangle_configuration_name(int configuration)
+  {
+    static const char* const names[nb_triangle_configurations] = { "3cycle", "3nocycle", "4cycle", "4outward", "4inward", "5cycle", "6cycle" };
+    return names[configuration];
+  }
+  // Configuration of the triangle A-B-C given the 6-bit mask formed by the directions of the edges
+  //   A-B, B-C and C-A (seen from A, B and C, respectively).
+  inline int triangle_configuration(int directions)
+  {
+    static const signed char configurations[64] = {
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1,  0,  1,  2, -1,  1,  1,  4, -1,  2,  3,  5,
+      -1, -1, -1, -1, -1,  1,  1,  3, -1,  1,  0,  2, -1,  4,  2,  5,
+      -1, -1, -1, -1, -1,  2,  4,  5, -1,  3,  2,  5, -1,  5,  5,  6 };
+    return configurations[directions];
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Triangle (IDs of its three vertices).
+  struct triangle_t
+  {
+    int vertices[3];
+    int& operator[](int i)             { return vertices[i]; }
+    const int& operator[](int i) const { return vertices[i]; }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Orders the vertices of a triangle by increasing ID. The directions of the edges (v0-v1, v1-v2
+  //   and v2-v0) are permuted accordingly.
+  inline void sort_triangle(triangle_t& triangle, int directions[3])
+  {
+    // Directions between every pair of vertices.
+    int pair_directions[3][3];
+    pair_directions[0][1] = directions[0];
+    pair_directions[1][2] = directions[1];
+    pair_directions[2][0] = directions[2];
+    pair_directions[1][0] = reverse_directions(directions[0]);
+    pair_directions[2][1] = reverse_directions(directions[1]);
+    pair_directions[0][2] = reverse_directions(directions[2]);
+    // Sorts the positions of the vertices.
+    int order[3] = {0, 1, 2};
+    if(triangle[order[1]] < triangle[order[0]]) { std::swap(order[0], order[1]); }
+    if(triangle[order[2]] < triangle[order[1]]) { std::swap(order[1], order[2]); }
+    if(triangle[order[1]] < triangle[order[0]]) { std::swap(order[0], order[1]); }
+    triangle_t sorted = {{ triangle[order[0]], triangle[order[1]], triangle[order[2]] }};
+    triangle = sorted;
+    directions[0] = pair_directions[order[0]][order[1]];
+    directions[1] = pair_directions[order[1]][order[2]];
+    directions[2] = pair_directions[order[2]][order[0]];
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Visitor compiling the outputs of survey_triangles (one per thread).
+  template<bool BuildTriangleList, bool ComputeUndirectedLocalClustering>
+  struct triangle_survey_visitor_t
+  {
+    // Triangles found in each block of vertices (shared by the threads).
+    std::vector< std::vector<triangle_t> >* block_triangles;
+    // Number of triangles each vertex belongs to (shared by the threads).
+    int64_t* nb_triangles_per_vertex;
+    // Number of triangles of each configuration.
+    double triangle_spect[nb_triangle_configurations];
+    triangle_survey_visitor_t() : block_triangles(NULL), nb_triangles_per_vertex(NULL) { std::fill(triangle_spect, triangle_spect + nb_triangle_configurations, 0); }
+    void operator()(int block, const triangle_t& triangle, int directions)
+    {
+      triangle_spect[triangle_configuration(directions)] += 1;
+      if(BuildTriangleList)
+      {
+        // Adds the triangle to the list of the block.
+        (*block_triangles)[block].push_back(triangle);
+      }
+      if(ComputeUndirectedLocalClustering)
+      {
+        // Compiles the undirected local clustering coefficients (1 of 2).
+        for(int i(0); i<3; ++i)
+        {
+          PGL_OMP(atomic)
+          nb_triangles_per_vertex[triangle[i]] += 1;
+        }
+      }
+    }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Calls a visitor of triangles provided by the user (see directed_graph_t::visit_triangles).
+  template<typename Visitor>
+  struct triangle_visitor_adapter_t
+  {
+    Visitor* visitor;
+    void operator()(int, const triangle_t& triangle, int directions) { (*visitor)(triangle[0], triangle[1], triangle[2], directions); }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Counts the triangles of every vertex and of every configuration (see visit_triangles). The
+  //   counts per vertex only extend to the largest vertex found in a triangle.
+  struct triangle_count_visitor_t
+  {
+    std::vector<int64_t> nb_triangles_per_vertex;
+    int64_t triangle_spect[nb_triangle_configurations];
+    triangle_count_visitor_t() { std::fill(triangle_spect, triangle_spect + nb_triangle_configurations, 0); }
+    void operator()(int v1, int v2, int v3, int directions)
+    {
+      // v3 is the largest of the three vertices.
+      if(v3 >= static_cast<int>(nb_triangles_per_vertex.size()))
+      {
+        nb_triangles_per_vertex.resize(v3 + 1, 0);
+      }
+      nb_triangles_per_vertex[v1] += 1;
+      nb_triangles_per_vertex[v2] += 1;
+      nb_triangles_per_vertex[v3] += 1;
+      triangle_spect[triangle_configuration(directions)] += 1;
+    }
+    void merge(const triangle_count_visitor_t& other)
+    {
+      if(other.nb_triangles_per_vertex.size() > nb_triangles_per_vertex.size())
+      {
+        nb_triangles_per_vertex.resize(other.nb_triangles_per_vertex.size(), 0);
+      }
+      for(int v(0), vv(other.nb_triangles_per_vertex.size()); v<vv; ++v)
+      {
+        nb_triangles_per_vertex[v] += other.nb_triangles_per_vertex[v];
+      }
+      for(int c(0); c<nb_triangle_configurations; ++c)
+      {
+        triangle_spect[c] += other.triangle_spect[c];
+      }
+    }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Hash function for names (64-bit FNV-1a).
+  inline uint64_t hash_name(const char* name, int length)
+  {
+    uint64_t h = 14695981039346656037ULL;
+    for(int i(0); i<length; ++i)
+    {
+      h ^= static_cast<unsigned char>(name[i]);
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Hash function for integers (splitmix64, used to sample or seed with a uniform 64-bit value).
+  inline uint64_t splitmix64(uint64_t x)
+  {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Pseudo-random number generator producing the splitmix64 sequence (fast, and sufficient to draw
+  //   samples).
+  class splitmix64_generator_t
+  {
+    private:
+      uint64_t state;
+    public:
+      explicit splitmix64_generator_t(uint64_t seed) : state(seed) {}
+      uint64_t operator()()
+      {
+        uint64_t r = splitmix64(state);
+        state += 0x9E3779B97F4A7C15ULL;
+        return r;
+      }
+      // Uniform integer in [0, n).
+      int uniform(int n) { return static_cast<int>(std::ldexp(static_cast<double>((*this)() >> 11), -53) * n); }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Bounds of the 95% confidence interval of an estimate whose sampling distribution is approximately
+  //   normal (the lower bound cannot be smaller than minimum).
+  inline void normal_confidence_interval(double estimate, double variance, double minimum, double& lower, double& upper)
+  {
+    double half_width = 1.959963984540054 * std::sqrt(variance);
+    lower = std::max(minimum, estimate - half_width);
+    upper = estimate + half_width;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Read-only reference to a name stored elsewhere (converts implicitly to std::string).
+  struct name_ref_t
+  {
+    const char* data;
+    int length;
+    name_ref_t(const char* d, int l) : data(d), length(l) {}
+    int size() const { return length; }
+    std::string str() const { return std::string(data, length); }
+    operator std::string() const { return str(); }
+    bool operator==(const std::string& other) const { return other.size() == static_cast<std::size_t>(length) && other.compare(0, length, data, length) == 0; }
+    bool operator!=(const std::string& other) const { return !(*this == other); }
+  };
+  // Writes the name (honors std::setw and the adjustment flags like std::string).
+  inline std::ostream& operator<<(std::ostream& os, const name_ref_t& name)
+  {
+    std::streamsize padding = os.width() - name.length;
+    bool left = (os.flags() & std::ios::adjustfield) == std::ios::left;
+    os.width(0);
+    for(; !left && padding > 0; --padding)
+    {
+      os.put(os.fill());
+    }
+    os.write(name.data, name.length);
+    for(; left && padding > 0; --padding)
+    {
+      os.put(os.fill());
+    }
+    return os;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Open addressing (linear probing) index over names identified by contiguous IDs. The names
+  //   themselves are stored by the owner of the index, which is passed to find() to compare them.
+  class name_index_t
+  {
+    template<typename EdgeOffset> friend class basic_directed_graph_t;
+    private:
+      // Slots contain the ID of a name (or -1 if empty); the number of slots is a power of 2.
+      array_t<int> slots;
+      // Hash value of each name, indexed by their ID.
+      array_t<uint32_t> hashes;
+    public:
+      int size() const { return hashes.size(); }
+      void clear() { slots.clear(); hashes.clear(); }
+      // Returns the ID of the name (or -1 if absent).
+      template<typename Names>
+      int find(const Names& names, const char* name, int length, uint32_t h) const
+      {
+        if(slots.empty())
+        {
+          return -1;
+        }
+        std::size_t mask = slots.size() - 1;
+        for(std::size_t s(h & mask); slots[s] != -1; s = (s + 1) & mask)
+        {
+          int id = slots[s];
+          if(hashes[id] == h && names.equal(id, name, length))
+          {
+            return id;
+          }
+        }
+        return -1;
+      }
+      // Indexes a new name whose ID is size() (load factor kept below 1/2).
+      void insert(uint32_t h)
+      {
+        std::vector<int>& owned_slots = slots.owned();
+        std::vector<uint32_t>& owned_hashes = hashes.owned();
+        if(2 * (owned_hashes.size() + 1) > owned_slots.size())
+        {
+          std::vector<int>(owned_slots.empty() ? 1024 : 2 * owned_slots.size(), -1).swap(owned_slots);
+          for(int id(0), nb_ids(owned_hashes.size()); id<nb_ids; ++id)
+          {
+            place(owned_slots, owned_hashes[id], id);
+          }
+        }
+        owned_hashes.push_back(h);
+        place(owned_slots, h, owned_hashes.size() - 1);
+      }
+    private:
+      static void place(std::vector<int>& owned_slots, uint32_t h, int id)
+      {
+        std::size_t mask = owned_slots.size() - 1;
+        std::size_t s = h & mask;
+        while(owned_slots[s] != -1)
+        {
+          s = (s + 1) & mask;
+        }
+        owned_slots[s] = id;
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Interned names. Every name is stored once, back to back in a single arena, and is assigned a
+  //   contiguous ID in [0, size()) in order of insertion.
+  class name_table_t
+  {
+    template<typename EdgeOffset> friend class basic_directed_graph_t;
+    private:
+      array_t<char> arena;
+      // The name of ID id is stored in arena[ offsets[id] ] to arena[ offsets[id+1] - 1 ].
+      array_t<uint64_t> offsets;
+      name_index_t index;
+    public:
+      name_table_t() { clear(); }
+      int size() const { return offsets.size() - 1; }
+      void clear() { arena.clear(); offsets.clear(); offsets.owned().assign(1, 0); index.clear(); }
+      // Name associated with an ID (the reference is invalidated by subsequent insertions).
+      name_ref_t name(int id) const { return name_ref_t(arena.data() + offsets[id], offsets[id + 1] - offsets[id]); }
+      bool equal(int id, const char* name, int length) const
+      {
+        return offsets[id + 1] - offsets[id] == static_cast<uint64_t>(length) && std::memcmp(arena.data() + offsets[id], name, length) == 0;
+      }
+      // Returns the ID of a name (or -1 if absent).
+      int find(const char* name, int length) const { return index.find(*this, name, length, hash_name(name, length)); }
+      int find(const std::string& name) const      { return find(name.data(), name.size()); }
+      // Returns the ID of a name, which is inserted if absent.
+      int insert(const char* name, int length)
+      {
+        uint32_t h = hash_name(name, length);
+        int id = index.find(*this, name, length, h);
+        if(id == -1)
+        {
+          id = size();
+          std::vector<char>& owned_arena = arena.owned();
+          owned_arena.insert(owned_arena.end(), name, name + length);
+          offsets.owned().push_back(owned_arena.size());
+          index.insert(h);
+        }
+        return id;
+      }
+      int insert(const std::string& name) { return insert(name.data(), name.size()); }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Read-only view of the names of a name_table_t indexed by their ID (no name is copied).
+  class name_table_view_t
+  {
+    private:
+      const name_table_t* table;
+    public:
+      name_table_view_t() : table(0) {}
+      void bind(const name_table_t& names) { table = &names; }
+      void clear() { table = 0; }
+      int size() const { return (table == 0) ? 0 : table->size(); }
+      name_ref_t operator[](int id) const { return table->name(id); }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Table assigning contiguous IDs, in order of first appearance, to names that are views into a
+  //   buffer owned elsewhere (e.g., a mapped file).
+  class name_view_table_t
+  {
+    public:
+      // Names, indexed by their ID.
+      std::vector<const char*> names;
+      std::vector<int> lengths;
+    private:
+      name_index_t index;
+    public:
+      int size() const { return names.size(); }
+      bool equal(int id, const char* name, int length) const
+      {
+        return lengths[id] == length && std::memcmp(names[id], name, length) == 0;
+      }
+      // Returns the ID of the name, assigning a new one if the name is new.
+      int insert(const char* name, int length)
+      {
+        uint32_t h = hash_name(name, length);
+        int id = index.find(*this, name, length, h);
+        if(id == -1)
+        {
+          id = names.size();
+          names.push_back(name);
+          lengths.push_back(length);
+          index.insert(h);
+        }
+        return id;
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Set of directed edges stored as a flat array of (source, target) pairs sorted in increasing
+  //   order. Edges inserted one at a time are kept aside in a std::set and are merged into the
+  //   array the next time the edges are traversed, while edges inserted in bulk are sorted and
+  //   deduplicated in a single (parallel) pass.
+  class edgelist_t
+  {
+    template<typename EdgeOffset> friend class basic_directed_graph_t;
+    public:
+      typedef std::pair<int, int> edge_t;
+      typedef const edge_t* iterator;
+    private:
+      array_t<edge_t> edges;
+      std::set<edge_t> pending_edges;
+      // Edges of the sorted array that have been removed one at a time.
+      std::set<edge_t> removed_edges;
+      // Merges the edges inserted (and removed) one at a time into the sorted array.
+      void flush()
+      {
+        if(!pending_edges.empty() || !removed_edges.empty())
+        {
+          std::vector<edge_t> kept(edges.size() - removed_edges.size());
+          std::set_difference(edges.begin(), edges.end(), removed_edges.begin(), removed_edges.end(), kept.begin());
+          std::vector<edge_t> merged(kept.size() + pending_edges.size());
+          std::merge(kept.begin(), kept.end(), pending_edges.begin(), pending_edges.end(), merged.begin());
+          edges.owned().swap(merged);
+          pending_edges.clear();
+          removed_edges.clear();
+        }
+      }
+    public:
+      std::size_t size() const { return edges.size() - removed_edges.size() + pending_edges.size(); }
+      bool empty() const { return size() == 0; }
+      // Checks whether edges have been inserted (or removed) one at a time since the last traversal.
+      bool has_pending_changes() const { return !pending_edges.empty() || !removed_edges.empty(); }
+      void clear() { edges.clear(); pending_edges.clear(); removed_edges.clear(); }
+      iterator begin() { flush(); return edges.begin(); }
+      iterator end()   { flush(); return edges.end();   }
+      // Checks whether an edge is in the set.
+      bool contains(const edge_t& edge) const
+      {
+        return (std::binary_search(edges.begin(), edges.end(), edge) && removed_edges.count(edge) == 0) || pending_edges.count(edge) != 0;
+      }
+      // Inserts an edge (returns false if the edge was already present).
+      bool insert(const edge_t& edge)
+      {
+        if(std::binary_search(edges.begin(), edges.end(), edge))
+        {
+          return removed_edges.erase(edge) != 0;
+        }
+        return pending_edges.insert(edge).second;
+      }
+      // Removes an edge (returns false if the edge was not present).
+      bool erase(const edge_t& edge)
+      {
+        if(pending_edges.erase(edge) != 0)
+        {
+          return true;
+        }
+        if(std::binary_search(edges.begin(), edges.end(), edge))
+        {
+          return removed_edges.insert(edge).second;
+        }
+        return false;
+      }
+      // Inserts edges in bulk after having removed self-loops and multiedges. The vector of new
+      //   edges is consumed. Returns the number of edges that were not already present.
+      std::size_t insert_bulk(std::vector<edge_t>& new_edges)
+      {
+        flush();
+        std::size_t previous_size = edges.size();
+        new_edges.erase(std::remove_if(new_edges.begin(), new_edges.end(), is_self_loop), new_edges.end());
+        parallel_sort(new_edges);
+        new_edges.erase(std::unique(new_edges.begin(), new_edges.end()), new_edges.end());
+        if(edges.empty())
+        {
+          edges.owned().swap(new_edges);
+        }
+        else
+        {
+          std::vector<edge_t> merged(edges.size() + new_edges.size());
+          merged.erase(std::set_union(edges.begin(), edges.end(), new_edges.begin(), new_edges.end(), merged.begin()), merged.end());
+          edges.owned().swap(merged);
+        }
+        std::vector<edge_t>().swap(new_edges);
+        return edges.size() - previous_size;
+      }
+    private:
+      static bool is_self_loop(const edge_t& edge) { return edge.first == edge.second; }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Streaming 64-bit checksum (the data is processed in words of 8 bytes, the last one being padded
+  //   with zeros).
+  class checksum_t
+  {
+    private:
+      uint64_t h;
+      uint64_t nb_bytes;
+      unsigned char partial_word[8];
+      void mix(uint64_t word)
+      {
+        h ^= word * 0x9E3779B97F4A7C15ULL;
+        h = ((h << 31) | (h >> 33)) * 0xC2B2AE3D27D4EB4FULL;
+      }
+    public:
+      checksum_t() : h(0xCBF29CE484222325ULL), nb_bytes(0) {}
+      void update(const void* data, std::size_t length)
+      {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        uint64_t word;
+        // Completes the pending partial word.
+        for(; length > 0 && nb_bytes % 8 != 0; --length)
+        {
+          partial_word[nb_bytes++ % 8] = *p++;
+          if(nb_bytes % 8 == 0)
+          {
+            std::memcpy(&word, partial_word, 8);
+            mix(word);
+          }
+        }
+        // Processes the whole words.
+        for(; length >= 8; p += 8, length -= 8, nb_bytes += 8)
+        {
+          std::memcpy(&word, p, 8);
+          mix(word);
+        }
+        // Keeps the remaining bytes aside.
+        if(length > 0)
+        {
+          std::memcpy(partial_word, p, length);
+          nb_bytes += length;
+        }
+      }
+      uint64_t value() const
+      {
+        checksum_t c(*this);
+        if(c.nb_bytes % 8 != 0)
+        {
+          uint64_t word;
+          std::memset(c.partial_word + c.nb_bytes % 8, 0, 8 - c.nb_bytes % 8);
+          std::memcpy(&word, c.partial_word, 8);
+          c.mix(word);
+        }
+        c.mix(c.nb_bytes);
+        return c.h;
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Header of binary snapshots. The header is followed by sections (aligned on 64 bytes) holding
+  //   the arrays of the graph as they are laid out in memory, such that a mapped snapshot can be
+  //   used in place. The payload checksum covers every byte following the header, and the header
+  //   checksum covers the header itself (with header_checksum set to 0).
+  struct binary_snapshot_header_t
+  {
+    enum section_t { names_arena_section, names_offsets_section, names_slots_section, names_hashes_section,
+                     edges_section, in_offsets_section, in_neighbors_section, out_offsets_section,
+                     out_neighbors_section, nb_sections };
+    static const uint32_t current_version = 2;
+    static const uint32_t byte_order_mark = 0x01020304;
+    static const uint64_t section_alignment = 64;
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t vertex_id_size;
+    uint32_t name_offset_size;
+    uint32_t edge_offset_size;
+    uint32_t reserved;
+    uint64_t nb_vertices;
+    uint64_t nb_edges;
+    uint64_t section_offset[nb_sections];
+    uint64_t section_size[nb_sections];
+    uint64_t payload_checksum;
+    uint64_t header_checksum;
+    // Header describing the current layout for adjacency lists indexed by offsets of
+    //   edge_offset_size bytes (sections are left empty).
+    static binary_snapshot_header_t blank(uint32_t edge_offset_size)
+    {
+      binary_snapshot_header_t header;
+      std::memset(&header, 0, sizeof(header));
+      std::memcpy(header.magic, "PGLGRAPH", 8);
+      header.version = current_version;
+      header.byte_order = byte_order_mark;
+      header.vertex_id_size = sizeof(int);
+      header.name_offset_size = sizeof(uint64_t);
+      header.edge_offset_size = edge_offset_size;
+      return header;
+    }
+    uint64_t compute_header_checksum() const
+    {
+      binary_snapshot_header_t header(*this);
+      header.header_checksum = 0;
+      checksum_t checksum;
+      checksum.update(&header, sizeof(header));
+      return checksum.value();
+    }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Writes a binary snapshot section by section (the content of a section can be streamed).
+  class binary_snapshot_writer_t
+  {
+    private:
+      std::ofstream file;
+      binary_snapshot_header_t header;
+      checksum_t checksum;
+      uint64_t position;
+    public:
+      binary_snapshot_writer_t(uint32_t edge_offset_size) : header(binary_snapshot_header_t::blank(edge_offset_size)), position(0) {}
+      // Opens the file and reserves the space for the header.
+      bool open(const std::string& filename)
+      {
+        file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        position = sizeof(header);
+        return file.good();
+      }
+      // Starts a new section (pads the file up to the alignment of sections).
+      void begin_section(int section)
+      {
+        static const char zeros[binary_snapshot_header_t::section_alignment] = {0};
+        write(zeros, (binary_snapshot_header_t::section_alignment - position % binary_snapshot_header_t::section_alignment) % binary_snapshot_header_t::section_alignment);
+        header.section_offset[section] = position;
+      }
+      // Appends bytes to the current section.
+      void write(const void* data, std::size_t nb_bytes)
+      {
+        file.write(static_cast<const char*>(data), nb_bytes);
+        checksum.update(data, nb_bytes);
+        position += nb_bytes;
+      }
+      void end_section(int section) { header.section_size[section] = position - header.section_offset[section]; }
+      // Writes a whole section at once.
+      template<typename T>
+      void write_section(int section, const T* data, std::size_t nb_elements)
+      {
+        begin_section(section);
+        write(data, nb_elements * sizeof(T));
+        end_section(section);
+      }
+      // Completes the header and closes the file (returns false if an error occurred).
+      bool close(uint64_t nb_vertices, uint64_t nb_edges)
+      {
+        header.nb_vertices = nb_vertices;
+        header.nb_edges = nb_edges;
+        header.payload_checksum = checksum.value();
+        header.header_checksum = header.compute_header_checksum();
+        file.seekp(0);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.close();
+        return !file.fail();
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Sorts edges, removes the multiedges and writes them into a file (a run of an external sort).
+  //   Returns false if an error occurred.
+  inline bool write_edge_run(const std::string& filename, std::vector< std::pair<int, int> >& edges)
+  {
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    std::FILE* file = std::fopen(filename.c_str(), "wb");
+    if(file == 0)
+    {
+      return false;
+    }
+    bool is_written = edges.empty() || std::fwrite(&edges[0], sizeof(edges[0]), edges.size(), file) == edges.size();
+    return (std::fclose(file) == 0) && is_written;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Merges sorted runs of edges written by write_edge_run (k-way merge), skipping the edges found in
+  //   several runs. Each run is read by blocks of a given number of edges.
+  class edge_run_merger_t
+  {
+    private:
+      typedef std::pair<int, int> edge_t;
+      struct run_t
+      {
+        std::FILE* file;
+        std::vector<edge_t> block;
+        std::size_t position;
+      };
+      std::vector<run_t> runs;
+      std::priority_queue< std::pair<edge_t, int>, std::vector< std::pair<edge_t, int> >, std::greater< std::pair<edge_t, int> > > heap;
+      edge_t last_edge;
+      bool has_last_edge;
+      // Pushes the next edge of a run onto the heap (reads the next block if needed).
+      void advance(int r)
+      {
+        run_t& run = runs[r];
+        if(run.position == run.block.size())
+        {
+          run.block.resize(run.block.capacity());
+          run.block.resize(std::fread(&run.block[0], sizeof(edge_t), run.block.size(), run.file));
+          run.position = 0;
+        }
+        if(run.position < run.block.size())
+        {
+          heap.push(std::make_pair(run.block[run.position++], r));
+        }
+      }
+    public:
+      edge_run_merger_t() : has_last_edge(false) {}
+      ~edge_run_merger_t() { close(); }
+      // Opens the runs (returns false if one of them could not be opened).
+      bool open(const std::vector<std::string>& filenames, std::size_t block_size)
+      {
+        close();
+        runs.resize(filenames.size());
+        for(int r(0), rr(runs.size()); r<rr; ++r)
+        {
+          runs[r].file = 0;
+        }
+        for(int r(0), rr(runs.size()); r<rr; ++r)
+        {
+          runs[r].file = std::fopen(filenames[r].c_str(), "rb");
+          if(runs[r].file == 0)
+          {
+            return false;
+          }
+          runs[r].block.reserve(std::max<std::size_t>(block_size, 1));
+          runs[r].position = 0;
+          advance(r);
+        }
+        return true;
+      }
+      // Extracts the next edge in sorted order (returns false once every run has been consumed).
+      bool next(edge_t& edge)
+      {
+        while(!heap.empty())
+        {
+          edge = heap.top().first;
+          int r = heap.top().second;
+          heap.pop();
+          advance(r);
+          if(!has_last_edge || edge != last_edge)
+          {
+            last_edge = edge;
+            has_last_edge = true;
+            return true;
+          }
+        }
+        return false;
+      }
+      void close()
+      {
+        for(int r(0), rr(runs.size()); r<rr; ++r)
+        {
+          if(runs[r].file != 0)
+          {
+            std::fclose(runs[r].file);
+          }
+        }
+        runs.clear();
+        heap = std::priority_queue< std::pair<edge_t, int>, std::vector< std::pair<edge_t, int> >, std::greater< std::pair<edge_t, int> > >();
+        has_last_edge = false;
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Writes the decimal representation of an integer into a buffer (of at least 21 characters) and
+  //   returns its length.
+  inline int format_integer(char* buffer, long long value)
+  {
+    char digits[24];
+    int nb_digits = 0;
+    unsigned long long magnitude = (value < 0) ? -static_cast<unsigned long long>(value) : value;
+    do
+    {
+      digits[nb_digits++] = '0' + magnitude % 10;
+      magnitude /= 10;
+    } while(magnitude != 0);
+    int length = 0;
+    if(value < 0)
+    {
+      buffer[length++] = '-';
+    }
+    while(nb_digits > 0)
+    {
+      buffer[length++] = digits[--nb_digits];
+    }
+    return length;
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Converts a token of text into a number like std::atof (integers are converted directly).
+  inline double parse_number(const char* token, int length)
+  {
+    bool negative = (length > 0 && token[0] == '-');
+    int i = (length > 0 && (token[0] == '-' || token[0] == '+')) ? 1 : 0;
+    if(length > i && length - i <= 18)
+    {
+      long long magnitude = 0;
+      for(; i<length && token[i] >= '0' && token[i] <= '9'; ++i)
+      {
+        magnitude = 10 * magnitude + (token[i] - '0');
+      }
+      if(i == length)
+      {
+        double value = magnitude;
+        return negative ? -value : value;
+      }
+    }
+    // Other numbers are copied so that they are terminated by a null character.
+    std::string copy(token, length);
+    return std::atof(copy.c_str());
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Writes a number like std::scientific with 6 digits of precision into a buffer (of at least 32
+  //   characters) and returns its length.
+  inline int format_scientific(char* buffer, double value)
+  {
+  #if defined(__cpp_lib_to_chars)
+    return std::to_chars(buffer, buffer + 32, value, std::chars_format::scientific, 6).ptr - buffer;
+  #else
+    return std::sprintf(buffer, "%.6e", value);
+  #endif
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Appends the decimal representation of an integer to a string.
+  inline void append_integer(std::string& text, long long value)
+  {
+    char buffer[24];
+    text.append(buffer, format_integer(buffer, value));
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Appends a field right-aligned on (at least) width characters, like std::setw.
+  inline void append_field(std::string& text, const char* field, int length, int width)
+  {
+    if(length < width)
+    {
+      text.append(width - length, ' ');
+    }
+    text.append(field, length);
+  }
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Header of binary triangle files, which is followed by nb_triangles triplets of vertex IDs.
+  struct binary_triangles_header_t
+  {
+    static const uint32_t current_version = 1;
+    char magic[8];
+    uint32_t version;
+    uint32_t vertex_id_size;
+    uint64_t nb_triangles;
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Writes triangles into a file as they are found. Triangles are accumulated into a buffer of
+  //   fixed size which, once full, is formatted and written by a background thread while the next
+  //   buffer is being filled (the writes are synchronous when compiled without C++11).
+  class triangle_writer_t
+  {
+    private:
+      // Number of triangles per buffer.
+      static const int buffer_size = 1 << 16;
+      std::ofstream file;
+      bool binary;
+      // Names of the vertices (IDs are written if NULL).
+      const name_table_view_t* names;
+      // Buffer being filled and buffer being written.
+      std::vector<triangle_t> buffers[2];
+      std::string text;
+      uint64_t nb_triangles;
+    #if __cplusplus >= 201103L
+      std::thread writer;
+    #endif
+      // Formats and writes a buffer.
+      void write(const std::vector<triangle_t>& triangles)
+      {
+        if(triangles.empty())
+        {
+          return;
+        }
+        if(binary)
+        {
+          file.write(reinterpret_cast<const char*>(&triangles[0]), triangles.size() * sizeof(triangle_t));
+          return;
+        }
+        text.clear();
+        for(int t(0), tt(triangles.size()); t<tt; ++t)
+        {
+          for(int i(0); i<3; ++i)
+          {
+            if(names == NULL)
+            {
+              append_integer(text, triangles[t][i]);
+            }
+            else
+            {
+              name_ref_t name = (*names)[ triangles[t][i] ];
+              text.append(name.data, name.length);
+            }
+            text += (i < 2) ? ' ' : '\n';
+          }
+        }
+        file.write(text.data(), text.size());
+      }
+      // Waits for the background write to complete.
+      void wait()
+      {
+      #if __cplusplus >= 201103L
+        if(writer.joinable())
+        {
+          writer.join();
+        }
+      #endif
+      }
+    public:
+      triangle_writer_t() : binary(false), names(NULL), nb_triangles(0) {}
+      ~triangle_writer_t() { wait(); }
+      // Opens the file (returns false if the file could not be opened).
+      bool open(const std::string& filename, bool binary_format, const name_table_view_t* vertex_names)
+      {
+        binary = binary_format;
+        names = vertex_names;
+        nb_triangles = 0;
+        buffers[0].reserve(buffer_size);
+        file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(binary)
+        {
+          // Reserves the space for the header.
+          binary_triangles_header_t header;
+          std::memset(&header, 0, sizeof(header));
+          file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        return file.good();
+      }
+      void push(const triangle_t& triangle)
+      {
+        buffers[0].push_back(triangle);
+        if(buffers[0].size() == static_cast<std::size_t>(buffer_size))
+        {
+          flush();
+        }
+      }
+      // Hands the current buffer to the writer.
+      void flush()
+      {
+        wait();
+        nb_triangles += buffers[0].size();
+        buffers[0].swap(buffers[1]);
+        buffers[0].clear();
+        buffers[0].reserve(buffer_size);
+      #if __cplusplus >= 201103L
+        writer = std::thread(&triangle_writer_t::write, this, std::cref(buffers[1]));
+      #else
+        write(buffers[1]);
+      #endif
+      }
+      // Writes the remaining triangles and closes the file (returns false if an error occurred).
+      bool close()
+      {
+        flush();
+        wait();
+        if(binary)
+        {
+          binary_triangles_header_t header;
+          std::memcpy(header.magic, "PGLTRIAN", 8);
+          header.version = binary_triangles_header_t::current_version;
+          header.vertex_id_size = sizeof(int);
+          header.nb_triangles = nb_triangles;
+          file.seekp(0);
+          file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        file.close();
+        return !file.fail();
+      }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Visitor writing the triangles into a file (and compiling the triangle spectrum).
+  struct triangle_export_visitor_t
+  {
+    triangle_writer_t* writer;
+    double triangle_spect[nb_triangle_configurations];
+    triangle_export_visitor_t(triangle_writer_t* w) : writer(w) { std::fill(triangle_spect, triangle_spect + nb_triangle_configurations, 0); }
+    void operator()(int, const triangle_t& triangle, int directions)
+    {
+      triangle_spect[triangle_configuration(directions)] += 1;
+      writer->push(triangle);
+    }
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Graph whose vertices are identified by 32-bit integers and whose adjacency lists are indexed
+  //   by offsets of type EdgeOffset. The width is chosen at compile time through the typedefs
+  //   below: directed_graph_t (32-bit offsets, up to 2^31 - 1 edges) and large_directed_graph_t
+  //   (64-bit offsets and counts).
+  template<typename EdgeOffset>
+  class basic_directed_graph_t
+  {
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Internal storage of the graph object.
+    public:
+      // Name to ID conversion. Every vertex is assigned a numerical ID in [0, |V|).
+      name_table_t Name2ID;
+      // Edgelist.
+      edgelist_t edgelist;
+      // Binary snapshot in which the arrays above may reside (see open_binary_snapshot).
+      mapped_file_t snapshot_file;
+      // Adjacency list in compressed sparse row (CSR) format. The in-neighbors (idx = InDegreeIdx)
+      //   and out-neighbors (idx = OutDegreeIdx) of vertex v are stored contiguously and sorted in
+      //   neighbors[idx][ offsets[idx][v] ] to neighbors[idx][ offsets[idx][v+1] - 1 ].
+      struct adjacency_list_t
+      {
+        array_t<EdgeOffset> offsets[2];
+        array_t<int> neighbors[2];
+        // Number of vertices covered by the adjacency list.
+        int size() const { return offsets[0].empty() ? 0 : offsets[0].size() - 1; }
+        void clear() { for(int i(0); i<2; ++i) { offsets[i].clear(); neighbors[i].clear(); } }
+      };
+      adjacency_list_t adjacency_list;
+      // Indices for the in and out degree in the adjacency list.
+      static const int InDegreeIdx = 0;
+      static const int OutDegreeIdx = 1;
+      // Index accelerating the edge queries (see has_edge). The neighbours of hubs (vertices whose
+      //   in- or out-degree is at least hub_min_degree) are stored in a bitmap over all vertices if
+      //   the hub is dense enough, and in a hash set otherwise. A Bloom filter over all edges can
+      //   optionally reject most of the queries about missing edges.
+      struct edge_index_t
+      {
+        struct hub_t
+        {
+          std::vector<uint64_t> bitmap;
+          std::vector<int> slots;
+          bool contains(int v) const;
+        };
+        // Position of each vertex in hubs (-1 for vertices that are not hubs).
+        std::vector<int> Vertex2Hub[2];
+        std::vector<hub_t> hubs[2];
+        std::vector<uint64_t> bloom_filter;
+        // Number of vertices covered by the index.
+        int size() const { return Vertex2Hub[0].size(); }
+        void clear() { for(int i(0); i<2; ++i) { Vertex2Hub[i].clear(); hubs[i].clear(); } bloom_filter.clear(); }
+        bool may_contain(int v_source, int v_target) const;
+        // Hash of an edge (mixing function of splitmix64).
+        static uint64_t hash(int v_source, int v_target)
+        {
+          uint64_t h = (static_cast<uint64_t>(v_source) << 32) | static_cast<uint32_t>(v_target);
+          h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ULL;
+          h = (h ^ (h >> 27)) * 0x94D049BB133111EBULL;
+          return h ^ (h >> 31);
+        }
+      };
+      edge_index_t edge_index;
+      static const int hub_min_degree = 1024;
+      // Adjacency list replacing adjacency_list once compressed (see compress_adjacency_list). The
+      //   sorted in-neighbors (idx = InDegreeIdx) and out-neighbors (idx = OutDegreeIdx) of the
+      //   vertices are encoded by compress_sorted one after the other in bytes[idx]. The position of
+      //   each list is stored in 32 bits relative to the first list of its block of vertices.
+      struct compressed_adjacency_list_t
+      {
+        static const int block_bits = 10;
+        std::vector<uint64_t> block_offsets[2];
+        std::vector<uint32_t> offsets[2];
+        std::vector<unsigned char> bytes[2];
+        // Number of vertices covered by the adjacency list.
+        int size() const { return offsets[0].size(); }
+        void clear()
+        {
+          for(int i(0); i<2; ++i)
+          {
+            std::vector<uint64_t>().swap(block_offsets[i]);
+            std::vector<uint32_t>().swap(offsets[i]);
+            std::vector<unsigned char>().swap(bytes[i]);
+          }
+        }
+        // Appends the neighbours of the next vertex.
+        void append(int idx, const int* neighbors, int nb_neighbors)
+        {
+          if((offsets[idx].size() & ((1 << block_bits) - 1)) == 0)
+          {
+            block_offsets[idx].push_back(bytes[idx].size());
+          }
+          uint64_t offset = bytes[idx].size() - block_offsets[idx].back();
+          if(offset > 0xFFFFFFFFULL)
+          {
+            std::cerr << "ERROR: A block of the compressed adjacency list exceeds 4 GiB." << std::endl;
+            std::terminate();
+          }
+          offsets[idx].push_back(offset);
+          compress_sorted(neighbors, nb_neighbors, bytes[idx]);
+        }
+        // Encoded neighbours of vertex v.
+        const unsigned char* list(int idx, int v) const { return &bytes[idx][0] + block_offsets[idx][v >> block_bits] + offsets[idx][v]; }
+      };
+      compressed_adjacency_list_t compressed_adjacency_list;
+      // Whether the edgelist has been released after the compression of the adjacency list (it is
+      //   then decoded from the compressed out-neighbors when needed, see restore_edgelist).
+      bool is_edgelist_released;
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Typedefs and accessors.
+    public:
+      typedef edgelist_t::iterator edgelist_iterator;
+      edgelist_iterator edgelist_begin() { restore_edgelist(); return edgelist.begin(); }
+      edgelist_iterator edgelist_end()   { restore_edgelist(); return edgelist.end();   }
+      // Lightweight view over a contiguous and sorted list of neighbors in the adjacency list.
+      struct neighbor_range_t
+      {
+        const int* first;
+        const int* last;
+        neighbor_range_t(const int* f, const int* l) : first(f), last(l) {}
+        const int* begin() const { return first; }
+        const int* end() const   { return last;  }
+        int size() const         { return last - first; }
+        bool empty() const       { return first == last; }
+        int operator[](int i) const { return first[i]; }
+      };
+      // Neighbors of vertex v (idx is either InDegreeIdx or OutDegreeIdx).
+      neighbor_range_t neighbors(int v, int idx) const
+      {
+        const int* base = adjacency_list.neighbors[idx].data();
+        return neighbor_range_t(base + adjacency_list.offsets[idx][v], base + adjacency_list.offsets[idx][v + 1]);
+      }
+      neighbor_range_t in_neighbors(int v) const  { return neighbors(v, InDegreeIdx);  }
+      neighbor_range_t out_neighbors(int v) const { return neighbors(v, OutDegreeIdx); }
+      // Neighbors of vertex v in the compressed adjacency list (decoded on the fly).
+      compressed_sorted_t compressed_neighbors(int v, int idx) const
+      {
+        return compressed_sorted_t(compressed_adjacency_list.list(idx, v));
+      }
+    private:
+      // Neighbors of vertex v in whichever adjacency list has been built (compressed lists are
+      //   decoded into the buffer).
+      neighbor_range_t neighbors(int v, int idx, std::vector<int>& buffer) const;
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Objects/functions related to outputs.
+    public:
+      // Custom types to indicate how to identify vertices in outputs.
+      enum vID_t { vID_none, vID_num, vID_name };
+      static const bool header_true = true;
+      static const bool header_false = false;
+      // ID to name conversion (view into the names stored in Name2ID).
+      name_table_view_t ID2Name;
+      // Build the ID2Name view.
+      void build_ID2Name();
+    private:
+      // IDs of the vertices ordered by name (shorter names first), as written in outputs.
+      std::vector<int> vertices_by_name;
+      // Ensures that vertices_by_name is up to date (vertices are only ever added, hence the order
+      //   only needs to be computed again when the number of vertices changes).
+      const std::vector<int>& order_vertices_by_name();
+      // Number of rows formatted at once by save_vertices_properties.
+      static const int output_block_size = 4096;
+      // Default width of columns.
+      static const int default_column_width = 15;
+      // Available vertex properties.
+      std::set< std::string > available_vertex_prop;
+      // Available vertex integer properties.
+      std::set< std::string > available_vertex_integer_prop;
+      // Headers associated with vertex properties.
+      std::map< std::string, std::string > v_prop_header;
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Properties.
+    public:
+      // Properties of the graph (typed statistics, also accessible by name).
+      graph_properties_t g_prop;
+      // Properties of vertices (columns of typed values).
+      vertex_property_store_t v_prop;
+    //   // Statistics of vertices.
+    //   std::map< std::string, std::map<int, double> > v_stat;
+      // List of all triangles.
+      std::vector<triangle_t> triangles;
+      // Triangle spectrum histogram.
+      std::map<std::string, int64_t> triangle_spect;
+    private:
+      // Function verifying whether a vertex property exists.
+      void is_vertex_property(std::string prop);
+      // Function verifying wether a vertex property qualifies as a "integer" property.
+      bool is_vertex_integer_property(std::string prop, bool exit_on_error);
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Functions loading/saving edgelists and vertices/edges properties.
+    public:
+      // Functions to add vertices and/or edges.
+      int add_vertex(const std::string& name_str, bool ignore_unknown_vertices = false);
+      int add_vertex(const char* name, int length, bool ignore_unknown_vertices = false);
+      bool add_edge(const std::string& name1_str, const std::string& name2_str, bool ignore_unknown_vertices = false);
+      bool add_edge(int v1, int v2);
+      // Removes an edge (returns false if the edge does not exist).
+      bool remove_edge(const std::string& name1_str, const std::string& name2_str);
+      bool remove_edge(int v1, int v2);
+      // Adds edges in bulk (self-loops, multiedges and edges involving unknown vertices are
+      //   ignored). The vector of new edges is consumed. Returns the number of edges added.
+      EdgeOffset add_edges(std::vector< std::pair<int, int> >& new_edges);
+    public:
+      // Loads the graph structure from an edgelist in a file.
+      void load_graph_from_edgelist_file(std::string edgelist_filename);
+      // Estimates the number of edges, the reciprocity, the number of triangles, the triangle
+      //   spectrum and the undirected global clustering coefficient in a single pass over an edgelist
+      //   file, keeping at most sample_size pairs of connected vertices in memory (about 64 bytes per
+      //   pair). The memory is not bounded by sample_size alone: it also grows in O(|V|) with the
+      //   names of the vertices (Name2ID) and the offsets of the sampled pairs of every vertex
+      //   (4 bytes per vertex). The graph is reset and only keeps its vertices (the edges are not
+      //   stored). The statistics are flagged as estimates in g_prop, with their 95% confidence
+      //   intervals, unless the file contains fewer than sample_size pairs of connected vertices
+      //   (they are then exact).
+      void estimate_properties_from_edgelist_file(std::string edgelist_filename, int sample_size, uint64_t seed = 0);
+      // Saves the structure of the graph (names, edges and adjacency list) into a binary snapshot.
+      void save_binary_snapshot(std::string snapshot_filename);
+      // Opens a binary snapshot. The file is mapped in memory and its arrays are used in place (they
+      //   are only copied if the graph is modified). The layout of the sections, the offsets of the
+      //   names and of the adjacency list and the hash slots are always verified. The edges and the
+      //   lists of neighbours are only verified by the payload checksum, which is optional since it
+      //   requires reading the whole file; without it, their content is trusted.
+      void open_binary_snapshot(std::string snapshot_filename, bool verify_checksum = false);
+      // Builds the binary snapshot of a graph whose edges do not fit in memory, and opens it. At most
+      //   memory_limit bytes of edges (at least min_edge_run_size edges) are held in memory at once:
+      //   the edges are spilled into sorted runs (temporary files named after the snapshot) which are
+      //   then merged into the sections of the snapshot, in several passes if there are too many runs
+      //   to read them all at once by blocks of min_edge_block_size edges. The limit covers the edges
+      //   only: the names of the vertices and the in-/out-degrees (two offsets per vertex) are kept
+      //   in memory in addition. The IDs of the vertices are the same as with
+      //   load_graph_from_edgelist_file.
+      void build_binary_snapshot_from_edgelist_file(std::string edgelist_filename, std::string snapshot_filename, std::size_t memory_limit);
+    private:
+      // Minimal size (in bytes) of the chunks of an edgelist file parsed in parallel.
+      static const int min_edgelist_chunk_size = 1 << 20;
+      // Minimal number of edges sorted in memory when building a snapshot out of core.
+      static const int min_edge_run_size = 1 << 16;
+      // Minimal number of edges read at once from each run when merging runs.
+      static const int min_edge_block_size = 1 << 12;
+      // Sorts the edges by source and by target, writes them into the next pair of runs (file names
+      //   are appended to run_filenames[OutDegreeIdx] and run_filenames[InDegreeIdx]) and clears them.
+      static void spill_edge_runs(std::vector< std::pair<int, int> >& edges, const std::string& prefix, std::vector<std::string> run_filenames[2]);
+      // Merges groups of runs into longer runs until they can all be read at once by blocks of at
+      //   least min_edge_block_size edges while holding at most nb_edges_in_memory edges (the file
+      //   names are replaced by those of the merged runs). Returns the size of the blocks.
+      static std::size_t reduce_edge_runs(std::vector<std::string>& filenames, std::size_t nb_edges_in_memory);
+      // Merges runs of edges and writes the second vertex of each edge into the current section of a
+      //   snapshot (returns the number of edges).
+      static uint64_t write_merged_neighbors(const std::vector<std::string>& filenames, std::size_t block_size, binary_snapshot_writer_t& writer);
+      // Number of consecutive vertices processed as a unit of work when surveying triangles.
+      static const int triangle_block_size = 64;
+      // Number of wedges sampled as a unit of work (with their own random generator) by
+      //   estimate_triangles.
+      static const int wedge_sample_block_size = 4096;
+      // Builds the undirected adjacency list (sorted union of the in- and out-neighbours) with the
+      //   direction of each edge (see edge_direction_t).
+      void build_undirected_adjacency_list(std::vector<EdgeOffset>& offsets, std::vector<int>& neighbors, std::vector<unsigned char>& directions);
+      // Orients the undirected adjacency list by degree (vertices are relabeled by their rank in
+      //   increasing order of undirected degree and only the neighbours of higher rank are kept,
+      //   sorted by rank). Rank2Vertex gives the original ID of each rank.
+      static void orient_by_degree(const std::vector<EdgeOffset>& offsets, const std::vector<int>& neighbors, const std::vector<unsigned char>& directions, std::vector<int>& Rank2Vertex, std::vector<EdgeOffset>& forward_offsets, std::vector<int>& forward_neighbors, std::vector<unsigned char>& forward_directions);
+      // Parses the edges in a chunk of an edgelist file using chunk-local IDs.
+      static void parse_edgelist_chunk(const char* first, const char* last, name_view_table_t& names, std::vector< std::pair<int, int> >& edges);
+      // Parses the names and the values of the requested columns in a chunk of a file of vertices
+      //   properties (values are stored row by row).
+      static void parse_vertex_properties_chunk(const char* first, const char* last, const std::vector<int>& usecols, std::vector<name_ref_t>& names, std::vector<double>& values);
+    public:
+      // Outputing the vertices properties (the last 3 inputs can be omitted and/or put in any order).
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID = vID_name, int width = default_column_width, bool header = header_true);
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID,            bool header,                      int width = default_column_width)                { save_vertices_properties(filename, props_id, vID, width, header); };
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, bool header,          vID_t vID = vID_name,             int width = default_column_width)                { save_vertices_properties(filename, props_id, vID, width, header); };
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, bool header,          int width,                        vID_t vID = vID_name)                            { save_vertices_properties(filename, props_id, vID, width, header); };
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, int width,            vID_t vID = vID_name,             bool header = header_true)                       { save_vertices_properties(filename, props_id, vID, width, header); };
+      void save_vertices_properties(std::string filename, std::vector<std::string> props_id, int width,            bool header,                      vID_t vID = vID_name)                            { save_vertices_properties(filename, props_id, vID, width, header); };
+      // Column of a file of vertices properties to load (column 0 corresponds to the names).
+      struct vertex_property_spec_t
+      {
+        int usecol;
+        std::string prop;
+        std::string prop_header;
+        vertex_property_spec_t(int c, std::string p, std::string h = "") : usecol(c), prop(p), prop_header(h) {}
+      };
+      // Loads vertices properties from a file.
+      void load_vertices_properties(std::string prop_filename, int usecol, std::string prop, std::string prop_header = "", bool ignore_unknown_vertices = true);
+      // Loads several vertices properties from a file, which is read only once.
+      void load_vertices_properties(std::string prop_filename, const std::vector<vertex_property_spec_t>& specs, bool ignore_unknown_vertices = true);
+      // Adding new vertex (integer) properties.
+      void add_new_vertex_integer_property(std::string prop, std::string prop_header = "");
+      void add_new_vertex_property(std::string prop, std::string prop_header = "");
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Functions building secondary objects related to the graph.
+    public:
+      // Builds the adjacency list.
+      void build_adjacency_list();
+      // Builds the index used by has_edge (it is otherwise built on the first query, which must then
+      //   not be made concurrently with other queries).
+      void build_edge_index(bool use_bloom_filter = false);
+      // Replaces the adjacency list by a compressed one in which the gaps between consecutive
+      //   neighbours are encoded as varints (typically 3 to 5 times smaller). The degrees, the
+      //   reciprocity, the triangles and the edge queries are then computed by decoding the lists on
+      //   the fly (has_edge then does not build its index). The edgelist can also be released, in
+      //   which case it is decoded back when needed (e.g., by edgelist_begin or when edges are added
+      //   or removed). Calling build_adjacency_list reverts to the uncompressed adjacency list.
+      void compress_adjacency_list(bool release_edgelist = false);
+      bool is_adjacency_list_compressed() const { return compressed_adjacency_list.size() == g_prop.nb_vertices && g_prop.nb_vertices > 0; }
+    private:
+      // Decodes the edgelist from the compressed adjacency list if it has been released.
+      void restore_edgelist();
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Functions extracting properties of graph/vertices/edges.
+    private:
+      // Function checking if directed edge already exists.
+      bool is_edge(int v_source, int v_target);
+    public:
+      // Checks whether the directed edge v_source -> v_target exists (in O(1) for hubs and in
+      //   O(log d) otherwise, or in O(log |E|) while edges added or removed one at a time are
+      //   pending).
+      bool has_edge(int v_source, int v_target);
+      // Computes the average value of a vertex property.
+      void compute_average_vertex_prop(std::string prop);
+      // Extracts the in-/out-degree of vertices.
+      void compute_degrees();
+      // Computes the density of the graph.
+      void compute_density();
+      // Computes the reciprocity.
+      void compute_reciprocity();
+      // Algorithms surveying the triangles. With triangles_by_vertex_order, the pairs of adjacent
+      //   vertices v1<v2 are visited by increasing ID and the triangles are listed in lexicographic
+      //   order. With triangles_by_degree_order, every edge is oriented toward the vertex of higher
+      //   degree and the triangles are found by intersecting the forward neighbourhoods, which is
+      //   much faster on graphs with hubs; the triangles are then listed in a different order.
+      enum triangle_engine_t { triangles_by_vertex_order, triangles_by_degree_order };
+      // Compiles a list of all triangles in the graph.
+      void survey_triangles(bool build_triangle_list = true, bool compute_undirected_local_clustering = true, triangle_engine_t engine = triangles_by_vertex_order);
+      // Calls visitor(v1, v2, v3, directions) for every triangle, where v1<v2<v3 are the IDs of its
+      //   vertices and where directions is a 6-bit mask giving the directions of the edges v1-v2,
+      //   v2-v3 and v3-v1 (2 bits each, see edge_direction_t and triangle_configuration). When
+      //   compiled with OpenMP, every thread but the first one uses its own visitor, constructed
+      //   with Visitor() (which must therefore start from an empty state), and these visitors are
+      //   then merged into the visitor with visitor.merge(other).
+      template<typename Visitor>
+      void visit_triangles(Visitor& visitor, triangle_engine_t engine = triangles_by_vertex_order);
+      // Compiles the number of every unique triangle configurations.
+      void compile_triangle_spectrum();
+      // Estimates the undirected global clustering coefficient, the number of triangles, the
+      //   triangle spectrum and the average undirected local clustering coefficient by sampling
+      //   wedges (pairs of edges sharing a vertex) uniformly at random, which is much faster than
+      //   surveying the triangles of large graphs. Wedges are sampled until a sequential stopping rule
+      //   guarantees the requested relative error with the requested confidence (or until
+      //   max_nb_samples wedges have been sampled, the intervals then follow Hoeffding's bound). The estimates are flagged in g_prop with their
+      //   confidence intervals. Returns the number of wedges sampled for each coefficient.
+      int64_t estimate_triangles(double relative_error = 0.01, double confidence = 0.95, uint64_t seed = 0, int64_t max_nb_samples = 1 << 26);
+      // Formats of the files in which triangles are written: text (one triangle per line) or binary
+      //   (binary_triangles_header_t followed by the IDs of the vertices as 32-bit integers).
+      enum triangle_file_format_t { triangles_text, triangles_binary };
+      // Writes the triangles into a file as they are found (the memory used does not depend on the
+      //   number of triangles). In text files, the vertices are identified by their name (vID_name)
+      //   or by their ID (vID_num). Also compiles nb_triangles and the triangle spectrum.
+      void save_triangles(std::string filename, triangle_file_format_t format = triangles_text, vID_t vID = vID_name, triangle_engine_t engine = triangles_by_vertex_order);
+    private:
+      // Surveys the triangles (the requested outputs are compiled in).
+      template<bool BuildTriangleList, bool ComputeUndirectedLocalClustering>
+      void survey_triangles(triangle_engine_t engine);
+      // Enumerates the triangles in parallel. The thread t calls (*thread_visitors[t])(b, triangle,
+      //   directions) for every triangle found in the block of vertices b. Also returns the offsets
+      //   of the undirected adjacency list.
+      template<typename Visitor>
+      void enumerate_triangles(std::vector<Visitor*>& thread_visitors, triangle_engine_t engine, std::vector<EdgeOffset>& undirected_offsets);
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Incremental updates of the metrics.
+    public:
+      // Computes the degrees, the reciprocity, the triangle counts and spectrum, and the undirected
+      //   clustering coefficients, which are then kept up to date by add_edge, add_edges,
+      //   remove_edge and add_vertex. Each change of edge costs a time proportional to the degrees
+      //   of its two vertices (the list of triangles is however not maintained and is cleared).
+      void enable_live_metrics();
+      // Stops updating the metrics (and releases the memory used to do so).
+      void disable_live_metrics();
+      bool live_metrics_enabled() const { return live_metrics.enabled; }
+    private:
+      // State used to update the metrics incrementally.
+      struct live_metrics_t
+      {
+        bool enabled;
+        // Sorted lists of in- and out-neighbours (indexed by InDegreeIdx and OutDegreeIdx).
+        std::vector< std::vector<int> > neighbors[2];
+        std::vector<int> undirected_degree;
+        std::vector<int64_t> nb_triangles_per_vertex;
+        int64_t triangle_spect[nb_triangle_configurations];
+        // Handles of the vertex properties that are kept up to date.
+        int in_degree, out_degree, reciprocal_degree, reciprocity_jaccard, reciprocity_ratio, undir_local_clust;
+        live_metrics_t() : enabled(false), in_degree(-1), out_degree(-1), reciprocal_degree(-1), reciprocity_jaccard(-1), reciprocity_ratio(-1), undir_local_clust(-1) { std::fill(triangle_spect, triangle_spect + nb_triangle_configurations, 0); }
+      };
+      live_metrics_t live_metrics;
+      bool has_live_edge(int v_source, int v_target) const;
+      // Directions of the edge(s) between two vertices (see edge_direction_t).
+      int live_directions(int v1, int v2) const;
+      // Sorted list of the neighbours of a vertex in the undirected graph.
+      void live_undirected_neighbors(int v, std::vector<int>& neighbors) const;
+      // Adds (sign = 1) or removes (sign = -1) the contribution of a vertex to the number of vertices
+      //   of degree 0 and 1.
+      void count_live_degree_class(int v, int sign);
+      // Extends the metrics to the vertices added since the last update.
+      void add_live_vertices();
+      // Updates the metrics of a vertex that depend on its counts.
+      void update_live_vertex(int v);
+      // Updates the metrics after the edge v1 -> v2 has been added or removed from the edgelist.
+      void update_live_edge(int v1, int v2, bool added);
+      // Updates the properties of the graph derived from the counts.
+      void update_live_statistics();
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Ordering of the vertices.
+    public:
+      // Orderings of the vertices improving the locality of the memory accesses in neighbourhoods:
+      //   by decreasing undirected degree, by breadth-first search (from the vertex of highest
+      //   degree of each component), by reverse Cuthill-McKee, or by a greedy Gorder-like ordering
+      //   (vertices sharing neighbours with the last few vertices placed are placed next).
+      enum vertex_order_t { order_by_degree, order_by_bfs, order_by_rcm, order_by_gorder };
+      // Renumbers the vertices. The names, the edgelist, the adjacency list (compressed or not), the
+      //   vertex properties and the list of triangles are renumbered consistently, such that the
+      //   outputs identifying the vertices by name are unchanged.
+      void reorder_vertices(vertex_order_t order);
+    private:
+      // Number of vertices placed last considered by the Gorder-like ordering.
+      static const int gorder_window_size = 5;
+      // Computes the new order of the vertices (Rank2Vertex gives the original ID of each rank).
+      void order_vertices(vertex_order_t order, std::vector<int>& Rank2Vertex);
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+    // Constructors (and related functions).
+    private:
+      // Function setting default values (to avoid requiring the C++11 standard).
+      void initialization();
+    public:
+      // Empty constructor.
+      basic_directed_graph_t() { initialization(); };
+      // Constructor with edgelist.
+      basic_directed_graph_t(std::string edgelist_filename) { initialization(); load_graph_from_edgelist_file(edgelist_filename); };
+      // Copy constructor and assignment (ID2Name must be bound to the Name2ID of the copy).
+      basic_directed_graph_t(const basic_directed_graph_t& other) { *this = other; };
+      basic_directed_graph_t& operator=(const basic_directed_graph_t& other);
+      // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+      // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+      // // Convert to python.
+      // public:
+      //   // Graph properties.
+      //   int get_nb_vertices();
+      //   int get_nb_edges();
+      //   int get_nb_reciprocal_edges();
+      //   double get_reciprocity();
+      //   // // Vertex properties.
+      //   // std::map<std::string, double> get_local_reciprocity();
+  };
+
+
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Compact graph (32-bit offsets) suited for graphs with less than 2^31 edges.
+  typedef basic_directed_graph_t<int32_t> directed_graph_t;
+  // Graph with 64-bit offsets and counts suited for graphs with 2^31 edges or more.
+  typedef basic_directed_graph_t<int64_t> large_directed_graph_t;
+}
+
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+bool pgl::mapped_file_t::open(const std::string& filename, bool sequential_access)
+{
+  close();
+  mapping = new mapping_t();
+  mapping->data = 0;
+  mapping->length = 0;
+  mapping->is_mapped = false;
+  mapping->nb_references = 1;
+#ifdef PGL_HAS_MMAP
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    close();
+    return false;
+  }
+  struct stat file_stat;
+  if(fstat(fd, &file_stat) != 0)
+  {
+    ::close(fd);
+    close();
+    return false;
+  }
+  mapping->length = file_stat.st_size;
+  if(mapping->length > 0)
+  {
+    void* address = mmap(0, mapping->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(address != MAP_FAILED)
+    {
+      madvise(address, mapping->length, sequential_access ? MADV_SEQUENTIAL : MADV_RANDOM);
+      mapping->data = static_cast<const char*>(address);
+      mapping->is_mapped = true;
+      ::close(fd);
+      return true;
+    }
+  }
+  ::close(fd);
+#endif
+  // Falls back on reading the whole file into a buffer.
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if( !file.is_open() )
+  {
+    close();
+    return false;
+  }
+  std::vector<char>& buffer = mapping->buffer;
+  file.seekg(0, std::ios::end);
+  buffer.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  if(!buffer.empty())
+  {
+    file.read(&buffer[0], buffer.size());
+  }
+  mapping->length = buffer.size();
+  mapping->data = buffer.empty() ? 0 : &buffer[0];
+  return true;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+void pgl::mapped_file_t::close()
+{
+  if(mapping != 0 && --mapping->nb_references == 0)
+  {
+#ifdef PGL_HAS_MMAP
+    if(mapping->is_mapped)
+    {
+      munmap(const_cast<char*>(mapping->data), mapping->length);
+    }
+#endif
+    delete mapping;
+  }
+  mapping = 0;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::initialization()
+{
+  // Available vertex properties.
+  available_vertex_prop.insert("in-degree");
+  available_vertex_prop.insert("out-degree");
+  available_vertex_prop.insert("reciprocal_degree");
+  available_vertex_prop.insert("reciprocity_jaccard");
+  available_vertex_prop.insert("reciprocity_ratio");
+  available_vertex_prop.insert("undir_local_clust");
+  // Available vertex integer properties.
+  available_vertex_integer_prop.insert("in-degree");
+  available_vertex_integer_prop.insert("out-degree");
+  // Headers for vertex properties.
+  v_prop_header["in-degree"]  = "InDeg";
+  v_prop_header["out-degree"] = "OutDeg";
+  v_prop_header["reciprocal_degree"] = "RecDeg";
+  v_prop_header["reciprocity_jaccard"] = "ReciproJacc";
+  v_prop_header["reciprocity_ratio"] = "ReciproRatio";
+  v_prop_header["undir_local_clust"] = "UnLocalClust";
+  // Graph properties are initialized by graph_stats_t (to "impossible" values for the properties
+  //   that have yet to be computed).
+  // The edgelist is held in memory.
+  is_edgelist_released = false;
+
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+pgl::basic_directed_graph_t<EdgeOffset>& pgl::basic_directed_graph_t<EdgeOffset>::operator=(const basic_directed_graph_t& other)
+{
+  if(this == &other)
+  {
+    return *this;
+  }
+  Name2ID = other.Name2ID;
+  edgelist = other.edgelist;
+  snapshot_file = other.snapshot_file;
+  adjacency_list = other.adjacency_list;
+  edge_index = other.edge_index;
+  compressed_adjacency_list = other.compressed_adjacency_list;
+  is_edgelist_released = other.is_edgelist_released;
+  vertices_by_name = other.vertices_by_name;
+  available_vertex_prop = other.available_vertex_prop;
+  available_vertex_integer_prop = other.available_vertex_integer_prop;
+  v_prop_header = other.v_prop_header;
+  g_prop = other.g_prop;
+  v_prop = other.v_prop;
+  triangles = other.triangles;
+  triangle_spect = other.triangle_spect;
+  live_metrics = other.live_metrics;
+  // The view of the other graph points into its own Name2ID.
+  ID2Name.clear();
+  if(other.ID2Name.size() > 0)
+  {
+    ID2Name.bind(Name2ID);
+  }
+  return *this;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// Structure containing the desired method to compared strings (put shorter ones before longer ones).
+struct compare_names_directed_graph_t
+{
+  bool operator()(const std::pair<std::string, int>& lhs, const std::pair<std::string, int>& rhs) const
+  {
+    if(lhs.first.size() == rhs.first.size())
+    {
+      if(lhs.first == rhs.first)
+      {
+        return lhs.second < rhs.second;
+      }
+      else
+      {
+        return lhs.first < rhs.first;
+      }
+    }
+    else
+    {
+      return lhs.first.size() < rhs.first.size();
+    }
+  }
+};
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// Vertex identified by its name, ordered like compare_names_directed_graph_t.
+struct named_vertex_t
+{
+  pgl::name_ref_t name;
+  int v;
+  named_vertex_t(const pgl::name_ref_t& n, int id) : name(n), v(id) {}
+  bool operator<(const named_vertex_t& other) const
+  {
+    if(name.length != other.name.length)
+    {
+      return name.length < other.name.length;
+    }
+    int comparison = std::memcmp(name.data, other.name.data, name.length);
+    return (comparison != 0) ? comparison < 0 : v < other.v;
+  }
+};
+
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 0. INTERNAL MANAGMENT: GENERATING SECONDARY OBJECTS
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::build_adjacency_list()
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  restore_edgelist();
+  compressed_adjacency_list.clear();
+  int nb_vertices = g_prop.nb_vertices;
+  if(edgelist.size() > static_cast<uint64_t>(std::numeric_limits<EdgeOffset>::max()))
+  {
+    std::cerr << "ERROR: The graph has too many edges to be indexed by " << 8 * sizeof(EdgeOffset) << "-bit edge offsets (see large_directed_graph_t)." << std::endl;
+    std::terminate();
+  }
+  EdgeOffset nb_edges = edgelist.size();
+  adjacency_list.clear();
+  edge_index.clear();
+  for(int idx(0); idx<2; ++idx)
+  {
+    adjacency_list.offsets[idx].owned().resize(nb_vertices + 1, 0);
+    adjacency_list.neighbors[idx].owned().resize(nb_edges);
+  }
+  std::vector<EdgeOffset>& in_offsets = adjacency_list.offsets[InDegreeIdx].owned();
+  std::vector<EdgeOffset>& out_offsets = adjacency_list.offsets[OutDegreeIdx].owned();
+  std::vector<int>& in_neighbors = adjacency_list.neighbors[InDegreeIdx].owned();
+  std::vector<int>& out_neighbors = adjacency_list.neighbors[OutDegreeIdx].owned();
+  // ===============================================================================================
+
+  // Counts the in-/out-degrees (shifted by one to turn them into offsets).
+  edgelist_iterator it = edgelist.begin();
+  edgelist_iterator end = edgelist.end();
+  for(; it!=end; ++it)
+  {
+    out_offsets[it->first + 1] += 1;
+    in_offsets[it->second + 1] += 1;
+  }
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    out_offsets[v + 1] += out_offsets[v];
+    in_offsets[v + 1] += in_offsets[v];
+  }
+
+  // Loops over all edges. Since the edgelist is ordered by (source, target), both the in- and
+  //   out-neighbors end up sorted.
+  int v1, v2;
+  EdgeOffset e(0);
+  std::vector<EdgeOffset> in_position(in_offsets.begin(), in_offsets.end() - 1);
+  for(it=edgelist.begin(); it!=end; ++it, ++e)
+  {
+    // Identifies the vertices.
+    v1 = it->first;
+    v2 = it->second;
+    // Adds the edge.
+    out_neighbors[e] = v2;
+    in_neighbors[in_position[v2]++] = v1;
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compress_adjacency_list(bool release_edgelist)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Ensures that the adjacency list has been built (unless it is already compressed).
+  if(!is_adjacency_list_compressed())
+  {
+    if(adjacency_list.size() != nb_vertices)
+    {
+      build_adjacency_list();
+    }
+
+    // Encodes the lists of neighbours.
+    compressed_adjacency_list.clear();
+    for(int idx(0); idx<2; ++idx)
+    {
+      compressed_adjacency_list.offsets[idx].reserve(nb_vertices);
+      for(int v(0); v<nb_vertices; ++v)
+      {
+        neighbor_range_t range = neighbors(v, idx);
+        compressed_adjacency_list.append(idx, range.begin(), range.size());
+      }
+      std::vector<unsigned char>(compressed_adjacency_list.bytes[idx]).swap(compressed_adjacency_list.bytes[idx]);
+    }
+
+    // Releases the uncompressed adjacency list (and the index which refers to it).
+    adjacency_list.clear();
+    edge_index.clear();
+  }
+
+  // Releases the edgelist.
+  if(release_edgelist && !is_edgelist_released)
+  {
+    edgelist.clear();
+    is_edgelist_released = true;
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::restore_edgelist()
+{
+  if(!is_edgelist_released)
+  {
+    return;
+  }
+
+  // The out-neighbours of the vertices, in order, are sorted by (source, target).
+  std::vector<edgelist_t::edge_t>& edges = edgelist.edges.owned();
+  edges.resize(g_prop.nb_edges);
+  EdgeOffset e(0);
+  for(int v(0), nb_vertices(compressed_adjacency_list.size()); v<nb_vertices; ++v)
+  {
+    compressed_sorted_t list = compressed_neighbors(v, OutDegreeIdx);
+    for(int neighbor; list.next(neighbor); ++e)
+    {
+      edges[e] = std::make_pair(v, neighbor);
+    }
+  }
+  is_edgelist_released = false;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+typename pgl::basic_directed_graph_t<EdgeOffset>::neighbor_range_t pgl::basic_directed_graph_t<EdgeOffset>::neighbors(int v, int idx, std::vector<int>& buffer) const
+{
+  if(adjacency_list.size() == g_prop.nb_vertices)
+  {
+    return neighbors(v, idx);
+  }
+  compressed_sorted_t list = compressed_neighbors(v, idx);
+  buffer.resize(list.size() + 1);
+  int size = list.decode(&buffer[0]);
+  return neighbor_range_t(&buffer[0], &buffer[0] + size);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::build_edge_index(bool use_bloom_filter)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  edge_index.clear();
+  // ===============================================================================================
+
+  // Ensures that the adjacency list has been built.
+  if(adjacency_list.size() != nb_vertices)
+  {
+    build_adjacency_list();
+  }
+  // Counted from the adjacency list since the edgelist may have been released.
+  EdgeOffset nb_edges = adjacency_list.offsets[OutDegreeIdx][nb_vertices];
+
+  // Indexes the neighbours of hubs.
+  for(int idx(0); idx<2; ++idx)
+  {
+    edge_index.Vertex2Hub[idx].assign(nb_vertices, -1);
+    for(int v(0); v<nb_vertices; ++v)
+    {
+      if(neighbors(v, idx).size() >= hub_min_degree)
+      {
+        edge_index.Vertex2Hub[idx][v] = edge_index.hubs[idx].size();
+        edge_index.hubs[idx].push_back(typename edge_index_t::hub_t());
+      }
+    }
+    PGL_OMP(parallel for schedule(dynamic, 1))
+    for(int v = 0; v < nb_vertices; ++v)
+    {
+      if(edge_index.Vertex2Hub[idx][v] == -1)
+      {
+        continue;
+      }
+      typename edge_index_t::hub_t& hub = edge_index.hubs[idx][ edge_index.Vertex2Hub[idx][v] ];
+      neighbor_range_t range = neighbors(v, idx);
+      // A bitmap takes less memory than a hash set when more than 1/64 of the vertices are
+      //   neighbours.
+      if(range.size() >= nb_vertices / 64)
+      {
+        hub.bitmap.assign((nb_vertices + 63) / 64, 0);
+        for(const int* it = range.begin(); it != range.end(); ++it)
+        {
+          hub.bitmap[*it >> 6] |= uint64_t(1) << (*it & 63);
+        }
+      }
+      else
+      {
+        // Open addressing with a load factor below 1/2.
+        uint32_t capacity = 1;
+        while(capacity < 2 * static_cast<uint32_t>(range.size()))
+        {
+          capacity *= 2;
+        }
+        hub.slots.assign(capacity, -1);
+        for(const int* it = range.begin(); it != range.end(); ++it)
+        {
+          uint32_t slot = (static_cast<uint32_t>(*it) * 0x9E3779B1u) & (capacity - 1);
+          while(hub.slots[slot] != -1)
+          {
+            slot = (slot + 1) & (capacity - 1);
+          }
+          hub.slots[slot] = *it;
+        }
+      }
+    }
+  }
+
+  // Builds the Bloom filter (about 16 bits per edge, 4 hashes).
+  if(use_bloom_filter)
+  {
+    uint64_t nb_bits = 64;
+    while(nb_bits < 16 * static_cast<uint64_t>(nb_edges))
+    {
+      nb_bits *= 2;
+    }
+    edge_index.bloom_filter.assign(nb_bits / 64, 0);
+    edgelist_iterator edges = edgelist.begin();
+    PGL_OMP(parallel for schedule(static))
+    for(EdgeOffset e = 0; e < nb_edges; ++e)
+    {
+      uint64_t h = edge_index_t::hash(edges[e].first, edges[e].second);
+      uint64_t h1 = h, h2 = (h >> 32) | 1;
+      for(int k(0); k<4; ++k, h1 += h2)
+      {
+        uint64_t bit = h1 & (nb_bits - 1);
+        PGL_OMP(atomic)
+        edge_index.bloom_filter[bit >> 6] |= uint64_t(1) << (bit & 63);
+      }
+    }
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::build_ID2Name()
+{
+  ID2Name.bind(Name2ID);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+const std::vector<int>& pgl::basic_directed_graph_t<EdgeOffset>::order_vertices_by_name()
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Returns the cached order if it is still valid.
+  if(static_cast<int>(vertices_by_name.size()) == nb_vertices)
+  {
+    return vertices_by_name;
+  }
+
+  // Ensures that the ID2Name has been built. Otherwise, build it.
+  if(ID2Name.size() != nb_vertices)
+  {
+    build_ID2Name();
+  }
+
+  // Sorts the vertices by name (same order as compare_names_directed_graph_t).
+  std::vector<named_vertex_t> named_vertices;
+  named_vertices.reserve(nb_vertices);
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    named_vertices.push_back(named_vertex_t(ID2Name[v], v));
+  }
+  parallel_sort(named_vertices);
+  vertices_by_name.resize(nb_vertices);
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    vertices_by_name[v] = named_vertices[v].v;
+  }
+  return vertices_by_name;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 0. ADDING AND CHECKING THE EXISTENCE OF VERTICES AND EDGES
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::is_edge(int v_source, int v_target)
+{
+  return has_edge(v_source, v_target);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::has_edge(int v_source, int v_target)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Unknown vertices.
+  if(v_source < 0 || v_source >= nb_vertices || v_target < 0 || v_target >= nb_vertices)
+  {
+    return false;
+  }
+
+  // Uses the lists of neighbours that are kept up to date, if any.
+  if(live_metrics.enabled)
+  {
+    return has_live_edge(v_source, v_target);
+  }
+
+  // Decodes the smallest of the two compressed lists of neighbours up to the vertex searched.
+  if(is_adjacency_list_compressed())
+  {
+    compressed_sorted_t out = compressed_neighbors(v_source, OutDegreeIdx);
+    compressed_sorted_t in = compressed_neighbors(v_target, InDegreeIdx);
+    compressed_sorted_t& list = (out.size() <= in.size()) ? out : in;
+    int searched = (out.size() <= in.size()) ? v_target : v_source;
+    int neighbor = -1;
+    while(neighbor < searched && list.next(neighbor)) {}
+    return neighbor == searched;
+  }
+
+  // Ensures that the index has been built. Edges added or removed one at a time since it was last
+  //   built are looked up in the edgelist instead, since rebuilding the index (in O(|E|)) after
+  //   each modification would dominate interleaved updates and queries.
+  if(adjacency_list.size() != nb_vertices || edge_index.size() != nb_vertices)
+  {
+    if(edgelist.has_pending_changes())
+    {
+      return edgelist.contains(std::make_pair(v_source, v_target));
+    }
+    build_edge_index();
+  }
+
+  // Rejects most of the missing edges.
+  if(!edge_index.may_contain(v_source, v_target))
+  {
+    return false;
+  }
+
+  // Looks into the neighbours of hubs.
+  int hub = edge_index.Vertex2Hub[OutDegreeIdx][v_source];
+  if(hub != -1)
+  {
+    return edge_index.hubs[OutDegreeIdx][hub].contains(v_target);
+  }
+  hub = edge_index.Vertex2Hub[InDegreeIdx][v_target];
+  if(hub != -1)
+  {
+    return edge_index.hubs[InDegreeIdx][hub].contains(v_source);
+  }
+
+  // Searches the smallest of the two lists of neighbours.
+  neighbor_range_t out = out_neighbors(v_source);
+  neighbor_range_t in = in_neighbors(v_target);
+  if(out.size() <= in.size())
+  {
+    return std::binary_search(out.begin(), out.end(), v_target);
+  }
+  return std::binary_search(in.begin(), in.end(), v_source);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::edge_index_t::hub_t::contains(int v) const
+{
+  if(!bitmap.empty())
+  {
+    return (bitmap[v >> 6] >> (v & 63)) & 1;
+  }
+  uint32_t mask = slots.size() - 1;
+  for(uint32_t s = (static_cast<uint32_t>(v) * 0x9E3779B1u) & mask; slots[s] != -1; s = (s + 1) & mask)
+  {
+    if(slots[s] == v)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::edge_index_t::may_contain(int v_source, int v_target) const
+{
+  if(bloom_filter.empty())
+  {
+    return true;
+  }
+  // Four positions derived from two hashes of the edge (double hashing).
+  uint64_t h = hash(v_source, v_target);
+  uint64_t mask = bloom_filter.size() * 64 - 1;
+  uint64_t h1 = h, h2 = (h >> 32) | 1;
+  for(int k(0); k<4; ++k, h1 += h2)
+  {
+    uint64_t bit = h1 & mask;
+    if(((bloom_filter[bit >> 6] >> (bit & 63)) & 1) == 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+int pgl::basic_directed_graph_t<EdgeOffset>::add_vertex(const std::string& name_str, bool ignore_unknown_vertices)
+{
+  return add_vertex(name_str.data(), name_str.size(), ignore_unknown_vertices);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+int pgl::basic_directed_graph_t<EdgeOffset>::add_vertex(const char* name, int length, bool ignore_unknown_vertices)
+{
+  // Numerical ID of the vertex.
+  int v = Name2ID.find(name, length);
+  // Is the vertex new?
+  if(v == -1)
+  {
+    v = g_prop.nb_vertices;
+    if(!ignore_unknown_vertices)
+    {
+      Name2ID.insert(name, length);
+      g_prop.nb_vertices = v + 1;
+      if(live_metrics.enabled)
+      {
+        add_live_vertices();
+      }
+      // The new vertex has no neighbours in the compressed adjacency list.
+      if(v > 0 && compressed_adjacency_list.size() == v)
+      {
+        for(int idx(0); idx<2; ++idx)
+        {
+          compressed_adjacency_list.append(idx, NULL, 0);
+        }
+      }
+    }
+  }
+  // Returns the numerical ID of the vertex.
+  return v;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::add_edge(const std::string& name1_str, const std::string& name2_str, bool ignore_unknown_vertices)
+{
+  // Ignores self-loops.
+  if(name1_str == name2_str)
+  {
+    return false;
+  }
+
+  // Source vertex.
+  int v1 = add_vertex(name1_str, ignore_unknown_vertices);
+  if(ignore_unknown_vertices)
+  {
+    if(v1 == g_prop.nb_vertices)
+    {
+      return false;
+    }
+  }
+
+  // Target vertex.
+  int v2 = add_vertex(name2_str, ignore_unknown_vertices);
+  if(ignore_unknown_vertices)
+  {
+    if(v2 == g_prop.nb_vertices)
+    {
+      return false;
+    }
+  }
+
+  // Adds the edge (multiedges are automatically ignored).
+  restore_edgelist();
+  bool edge_added = edgelist.insert(std::make_pair(v1, v2));
+  if(edge_added)
+  {
+    g_prop.nb_edges += 1;
+    g_prop.invalidate_edge_statistics();
+    adjacency_list.clear();
+    compressed_adjacency_list.clear();
+    edge_index.clear();
+    triangle_spect.clear();
+    if(live_metrics.enabled)
+    {
+      update_live_edge(v1, v2, true);
+    }
+  }
+  return edge_added;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::add_edge(int v1, int v2)
+{
+  // Ignores self-loops.
+  if(v1 == v2)
+  {
+    return false;
+  }
+
+  // Does not add the edge if vertices do not exist.
+  if(v1 < 0 || v1 >= g_prop.nb_vertices)
+  {
+    return false;
+  }
+  if(v2 < 0 || v2 >= g_prop.nb_vertices)
+  {
+    return false;
+  }
+
+  // Adds the edge (multiedges are automatically ignored).
+  restore_edgelist();
+  bool edge_added = edgelist.insert(std::make_pair(v1, v2));
+  if(edge_added)
+  {
+    g_prop.nb_edges += 1;
+    g_prop.invalidate_edge_statistics();
+    adjacency_list.clear();
+    compressed_adjacency_list.clear();
+    edge_index.clear();
+    triangle_spect.clear();
+    if(live_metrics.enabled)
+    {
+      update_live_edge(v1, v2, true);
+    }
+  }
+  return edge_added;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::remove_edge(const std::string& name1_str, const std::string& name2_str)
+{
+  return remove_edge(Name2ID.find(name1_str.data(), name1_str.size()), Name2ID.find(name2_str.data(), name2_str.size()));
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::remove_edge(int v1, int v2)
+{
+  // Ignores self-loops and unknown vertices.
+  if(v1 == v2 || v1 < 0 || v2 < 0 || v1 >= g_prop.nb_vertices || v2 >= g_prop.nb_vertices)
+  {
+    return false;
+  }
+
+  // Removes the edge.
+  restore_edgelist();
+  bool edge_removed = edgelist.erase(std::make_pair(v1, v2));
+  if(edge_removed)
+  {
+    g_prop.nb_edges -= 1;
+    g_prop.invalidate_edge_statistics();
+    adjacency_list.clear();
+    compressed_adjacency_list.clear();
+    edge_index.clear();
+    triangle_spect.clear();
+    if(live_metrics.enabled)
+    {
+      update_live_edge(v1, v2, false);
+    }
+  }
+  return edge_removed;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+EdgeOffset pgl::basic_directed_graph_t<EdgeOffset>::add_edges(std::vector< std::pair<int, int> >& new_edges)
+{
+  // Adds the edges one at a time if the metrics are updated incrementally.
+  if(live_metrics.enabled)
+  {
+    EdgeOffset nb_edges_added = 0;
+    for(std::size_t e(0), ee(new_edges.size()); e<ee; ++e)
+    {
+      nb_edges_added += add_edge(new_edges[e].first, new_edges[e].second);
+    }
+    std::vector< std::pair<int, int> >().swap(new_edges);
+    return nb_edges_added;
+  }
+
+  // Does not add the edges if vertices do not exist.
+  int nb_vertices = g_prop.nb_vertices;
+  std::size_t nb_valid_edges = 0;
+  for(std::size_t e(0), ee(new_edges.size()); e<ee; ++e)
+  {
+    if(new_edges[e].first >= 0 && new_edges[e].first < nb_vertices && new_edges[e].second >= 0 && new_edges[e].second < nb_vertices)
+    {
+      new_edges[nb_valid_edges++] = new_edges[e];
+    }
+  }
+  new_edges.resize(nb_valid_edges);
+
+  // Adds the edges (self-loops and multiedges are automatically ignored).
+  restore_edgelist();
+  EdgeOffset nb_edges_added = edgelist.insert_bulk(new_edges);
+  g_prop.nb_edges += nb_edges_added;
+  if(nb_edges_added > 0)
+  {
+    g_prop.invalidate_edge_statistics();
+    adjacency_list.clear();
+    compressed_adjacency_list.clear();
+    edge_index.clear();
+    triangle_spect.clear();
+  }
+  return nb_edges_added;
+}
+
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 0. MANAGING VERTEX PROPERTIES
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::is_vertex_integer_property(std::string prop, bool exit_on_error)
+{
+  bool is_not = available_vertex_integer_prop.find(prop) == available_vertex_integer_prop.end();
+  if(exit_on_error)
+  {
+    if(is_not)
+    {
+      std::cerr << "ERROR: " << prop << " is not a valid vertex integer property." << std::endl;
+      std::terminate();
+    }
+  }
+  return !is_not;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::is_vertex_property(std::string prop)
+{
+  if(available_vertex_prop.find(prop) == available_vertex_prop.end())
+  {
+    std::cerr << "ERROR: " << prop << " is not a valid vertex property." << std::endl;
+    std::terminate();
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::add_new_vertex_integer_property(std::string prop, std::string prop_header)
+{
+  add_new_vertex_property(prop, prop_header);
+  if(available_vertex_integer_prop.find(prop) != available_vertex_integer_prop.end())
+  {
+    std::cerr << "ERROR: Vertex integer property " << prop << " already exists." << std::endl;
+    std::terminate();
+  }
+  available_vertex_integer_prop.insert(prop);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::add_new_vertex_property(std::string prop, std::string prop_header)
+{
+  if(prop_header == "")
+  {
+    prop_header = prop;
+  }
+  if(available_vertex_prop.find(prop) != available_vertex_prop.end())
+  {
+    std::cerr << "ERROR: Vertex property " << prop << " already exists." << std::endl;
+    std::terminate();
+  }
+  available_vertex_prop.insert(prop);
+  int nb_vertices = g_prop.nb_vertices;
+  v_prop_header[prop] = prop_header;
+  v_prop.create(prop, column_double).resize(nb_vertices, 0);
+}
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 1. INTERNAL MANAGMENT: AVERAGE VALUES OF VERTEX PROPERTIES
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compute_average_vertex_prop(std::string prop)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  const vertex_column_t& Vertex2Prop = v_prop[prop];
+  // ===============================================================================================
+
+  // Checks if the property has been extracted/computed already.
+  if(Vertex2Prop.size() != nb_vertices)
+  {
+    std::cerr << "ERROR: The property " << prop << " has not been extracted/computed." << std::endl;
+    std::terminate();
+  }
+
+  // Computes the average degree of vertices.
+  double sum_of_values = Vertex2Prop.sum();
+
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  std::string avg_v_prop = "avg_" + prop;
+  g_prop[avg_v_prop] = sum_of_values / nb_vertices;
+  // ===============================================================================================
+}
+
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 2. INPUT
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::load_graph_from_edgelist_file(std::string edgelist_filename)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  disable_live_metrics();
+  edgelist.clear();
+  compressed_adjacency_list.clear();
+  is_edgelist_released = false;
+  // ===============================================================================================
+
+  // Maps the file in memory and terminates if the operation did not succeed.
+  mapped_file_t edgelist_file;
+  if( !edgelist_file.open(edgelist_filename) )
+  {
+    std::cerr << "ERROR: Could not open file: " << edgelist_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // Splits the file into chunks of whole lines (one per thread).
+  const char* first = edgelist_file.begin();
+  const char* last = edgelist_file.end();
+  int nb_chunks = std::max(1, std::min<int>(max_nb_threads(), edgelist_file.size() / min_edgelist_chunk_size));
+  std::vector<const char*> chunk_bounds(nb_chunks + 1, last);
+  chunk_bounds[0] = first;
+  for(int c(1); c<nb_chunks; ++c)
+  {
+    const char* pos = std::max(chunk_bounds[c - 1], first + (edgelist_file.size() / nb_chunks) * c);
+    const char* eol = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+    chunk_bounds[c] = (eol == 0) ? last : eol + 1;
+  }
+
+  // Parses the chunks in parallel with chunk-local names tables.
+  std::vector<name_view_table_t> chunk_names(nb_chunks);
+  std::vector< std::vector< std::pair<int, int> > > chunk_edges(nb_chunks);
+  PGL_OMP(parallel for schedule(static, 1))
+  for(int c = 0; c < nb_chunks; ++c)
+  {
+    parse_edgelist_chunk(chunk_bounds[c], chunk_bounds[c + 1], chunk_names[c], chunk_edges[c]);
+  }
+
+  // Assigns the global IDs. Chunks are merged in the order in which they appear in the file and
+  //   the names of each chunk in order of first appearance, which yields the same IDs as reading
+  //   the file sequentially.
+  std::vector< std::vector<int> > local2global(nb_chunks);
+  for(int c(0); c<nb_chunks; ++c)
+  {
+    local2global[c].resize(chunk_names[c].size());
+    for(int i(0), ii(chunk_names[c].size()); i<ii; ++i)
+    {
+      local2global[c][i] = add_vertex(chunk_names[c].names[i], chunk_names[c].lengths[i], false);
+    }
+    chunk_names[c] = name_view_table_t();
+  }
+
+  // Translates the edges in terms of global IDs.
+  PGL_OMP(parallel for schedule(static, 1))
+  for(int c = 0; c < nb_chunks; ++c)
+  {
+    std::vector< std::pair<int, int> >& edges = chunk_edges[c];
+    for(EdgeOffset e(0), ee(edges.size()); e<ee; ++e)
+    {
+      edges[e].first = local2global[c][edges[e].first];
+      edges[e].second = local2global[c][edges[e].second];
+    }
+  }
+
+  // Gathers the edges into a single array.
+  std::size_t nb_raw_edges = 0;
+  for(int c(0); c<nb_chunks; ++c)
+  {
+    nb_raw_edges += chunk_edges[c].size();
+  }
+  std::vector< std::pair<int, int> > raw_edges;
+  raw_edges.reserve(nb_raw_edges);
+  for(int c(0); c<nb_chunks; ++c)
+  {
+    raw_edges.insert(raw_edges.end(), chunk_edges[c].begin(), chunk_edges[c].end());
+    std::vector< std::pair<int, int> >().swap(chunk_edges[c]);
+  }
+
+  // Adds the edges in bulk (multiedges are automatically ignored).
+  add_edges(raw_edges);
+  // Releases the file.
+  edgelist_file.close();
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  // g_prop["nb_edges"] = edgelist.size();
+  compute_density();
+  // ===============================================================================================
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::open_binary_snapshot(std::string snapshot_filename, bool verify_checksum)
+{
+  typedef binary_snapshot_header_t header_t;
+
+  // Maps the file in memory and terminates if the operation did not succeed.
+  mapped_file_t file;
+  if( !file.open(snapshot_filename, false) )
+  {
+    std::cerr << "ERROR: Could not open file: " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // Validates the header.
+  header_t header = header_t::blank(sizeof(EdgeOffset));
+  bool is_valid = file.size() >= sizeof(header_t);
+  if(is_valid)
+  {
+    std::memcpy(&header, file.begin(), sizeof(header_t));
+    is_valid = std::memcmp(header.magic, "PGLGRAPH", 8) == 0 && header.header_checksum == header.compute_header_checksum();
+  }
+  if(!is_valid)
+  {
+    std::cerr << "ERROR: " << snapshot_filename << " is not a valid binary snapshot." << std::endl;
+    std::terminate();
+  }
+  if(header.version != header_t::current_version || header.byte_order != header_t::byte_order_mark ||
+     header.vertex_id_size != sizeof(int) || header.name_offset_size != sizeof(uint64_t))
+  {
+    std::cerr << "ERROR: The binary snapshot " << snapshot_filename << " has been written with an incompatible version or on an incompatible platform." << std::endl;
+    std::terminate();
+  }
+  if(header.edge_offset_size != sizeof(EdgeOffset))
+  {
+    std::cerr << "ERROR: The binary snapshot " << snapshot_filename << " has been written with " << 8 * header.edge_offset_size << "-bit edge offsets but is opened by a graph using " << 8 * sizeof(EdgeOffset) << "-bit edge offsets." << std::endl;
+    std::terminate();
+  }
+  uint64_t nb_vertices = header.nb_vertices;
+  uint64_t nb_edges = header.nb_edges;
+  bool is_consistent = nb_vertices <= static_cast<uint64_t>(std::numeric_limits<int>::max()) &&
+                       nb_edges <= static_cast<uint64_t>(std::numeric_limits<EdgeOffset>::max());
+  uint64_t expected_size[header_t::nb_sections];
+  expected_size[header_t::names_offsets_section] = (nb_vertices + 1) * sizeof(uint64_t);
+  expected_size[header_t::names_hashes_section] = nb_vertices * sizeof(uint32_t);
+  expected_size[header_t::edges_section] = nb_edges * sizeof(edgelist_t::edge_t);
+  expected_size[header_t::in_offsets_section] = (nb_vertices + 1) * sizeof(EdgeOffset);
+  expected_size[header_t::out_offsets_section] = (nb_vertices + 1) * sizeof(EdgeOffset);
+  expected_size[header_t::in_neighbors_section] = nb_edges * sizeof(int);
+  expected_size[header_t::out_neighbors_section] = nb_edges * sizeof(int);
+  for(int k(0); k<header_t::nb_sections; ++k)
+  {
+    bool has_expected_size = (k == header_t::names_arena_section || k == header_t::names_slots_section || header.section_size[k] == expected_size[k]);
+    if( !is_consistent || !has_expected_size || header.section_offset[k] % header_t::section_alignment != 0 ||
+        header.section_size[k] > file.size() || header.section_offset[k] > file.size() - header.section_size[k] )
+    {
+      std::cerr << "ERROR: The binary snapshot " << snapshot_filename << " is truncated or corrupted." << std::endl;
+      std::terminate();
+    }
+  }
+  if(verify_checksum)
+  {
+    checksum_t checksum;
+    checksum.update(file.begin() + sizeof(header_t), file.size() - sizeof(header_t));
+    if(checksum.value() != header.payload_checksum)
+    {
+      std::cerr << "ERROR: The checksum of the binary snapshot " << snapshot_filename << " does not match its content." << std::endl;
+      std::terminate();
+    }
+  }
+
+  // Verifies the structure of the arrays (names and offsets must be increasing and end with the
+  //   size of the array they index, the number of slots must be a power of 2 leaving at least one
+  //   slot empty, and the slots must contain valid IDs).
+  const char* data = file.begin();
+  const uint64_t* name_offsets = reinterpret_cast<const uint64_t*>(data + header.section_offset[header_t::names_offsets_section]);
+  is_consistent = name_offsets[0] == 0 && name_offsets[nb_vertices] == header.section_size[header_t::names_arena_section];
+  for(uint64_t v(0); v<nb_vertices && is_consistent; ++v)
+  {
+    is_consistent = name_offsets[v] <= name_offsets[v + 1];
+  }
+  const int* slots = reinterpret_cast<const int*>(data + header.section_offset[header_t::names_slots_section]);
+  uint64_t nb_slots = header.section_size[header_t::names_slots_section] / sizeof(int);
+  is_consistent = is_consistent && header.section_size[header_t::names_slots_section] % sizeof(int) == 0 &&
+                  (nb_slots & (nb_slots - 1)) == 0 && (nb_slots > nb_vertices || nb_slots == 0) && (nb_slots > 0 || nb_vertices == 0);
+  for(uint64_t s(0); s<nb_slots && is_consistent; ++s)
+  {
+    is_consistent = slots[s] >= -1 && slots[s] < static_cast<int64_t>(nb_vertices);
+  }
+  const int offsets_sections[2] = {header_t::in_offsets_section, header_t::out_offsets_section};
+  for(int idx(0); idx<2 && is_consistent; ++idx)
+  {
+    const EdgeOffset* offsets = reinterpret_cast<const EdgeOffset*>(data + header.section_offset[offsets_sections[idx]]);
+    is_consistent = offsets[0] == 0 && static_cast<uint64_t>(offsets[nb_vertices]) == nb_edges;
+    for(uint64_t v(0); v<nb_vertices && is_consistent; ++v)
+    {
+      is_consistent = offsets[v] <= offsets[v + 1];
+    }
+  }
+  if(!is_consistent)
+  {
+    std::cerr << "ERROR: The binary snapshot " << snapshot_filename << " is truncated or corrupted." << std::endl;
+    std::terminate();
+  }
+
+  // Resets the graph and uses the arrays of the snapshot in place.
+  *this = basic_directed_graph_t();
+  snapshot_file = file;
+  const char* base = snapshot_file.begin();
+  Name2ID.arena.borrow(base + header.section_offset[header_t::names_arena_section], header.section_size[header_t::names_arena_section]);
+  Name2ID.offsets.borrow(reinterpret_cast<const uint64_t*>(base + header.section_offset[header_t::names_offsets_section]), nb_vertices + 1);
+  Name2ID.index.slots.borrow(reinterpret_cast<const int*>(base + header.section_offset[header_t::names_slots_section]), header.section_size[header_t::names_slots_section] / sizeof(int));
+  Name2ID.index.hashes.borrow(reinterpret_cast<const uint32_t*>(base + header.section_offset[header_t::names_hashes_section]), nb_vertices);
+  edgelist.edges.borrow(reinterpret_cast<const edgelist_t::edge_t*>(base + header.section_offset[header_t::edges_section]), nb_edges);
+  adjacency_list.offsets[InDegreeIdx].borrow(reinterpret_cast<const EdgeOffset*>(base + header.section_offset[header_t::in_offsets_section]), nb_vertices + 1);
+  adjacency_list.offsets[OutDegreeIdx].borrow(reinterpret_cast<const EdgeOffset*>(base + header.section_offset[header_t::out_offsets_section]), nb_vertices + 1);
+  adjacency_list.neighbors[InDegreeIdx].borrow(reinterpret_cast<const int*>(base + header.section_offset[header_t::in_neighbors_section]), nb_edges);
+  adjacency_list.neighbors[OutDegreeIdx].borrow(reinterpret_cast<const int*>(base + header.section_offset[header_t::out_neighbors_section]), nb_edges);
+
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  g_prop.nb_vertices = nb_vertices;
+  g_prop.nb_edges = nb_edges;
+  compute_density();
+  // ===============================================================================================
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::build_binary_snapshot_from_edgelist_file(std::string edgelist_filename, std::string snapshot_filename, std::size_t memory_limit)
+{
+  typedef binary_snapshot_header_t header_t;
+
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  *this = basic_directed_graph_t();
+  // ===============================================================================================
+
+  // Maps the file in memory and terminates if the operation did not succeed.
+  mapped_file_t edgelist_file;
+  if( !edgelist_file.open(edgelist_filename) )
+  {
+    std::cerr << "ERROR: Could not open file: " << edgelist_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // Reads the edges sequentially (which yields the same IDs as load_graph_from_edgelist_file) and
+  //   spills them into sorted runs whenever the buffer is full.
+  std::size_t nb_edges_in_memory = std::max<std::size_t>(min_edge_run_size, memory_limit / sizeof(std::pair<int, int>));
+  std::vector<std::string> run_filenames[2];
+  std::vector< std::pair<int, int> > edges;
+  edges.reserve(nb_edges_in_memory);
+  const char *name1, *name2;
+  int length1, length2;
+  text_scanner_t scanner(edgelist_file.begin(), edgelist_file.end());
+  while( scanner.next_line() )
+  {
+    if( !scan_edge(scanner, name1, length1, name2, length2) )
+    {
+      continue;
+    }
+    int v1 = add_vertex(name1, length1, false);
+    int v2 = add_vertex(name2, length2, false);
+    edges.push_back(std::make_pair(v1, v2));
+    if(edges.size() == nb_edges_in_memory)
+    {
+      spill_edge_runs(edges, snapshot_filename, run_filenames);
+    }
+  }
+  if(!edges.empty() || run_filenames[OutDegreeIdx].empty())
+  {
+    spill_edge_runs(edges, snapshot_filename, run_filenames);
+  }
+  std::vector< std::pair<int, int> >().swap(edges);
+  edgelist_file.close();
+
+  // Opens the snapshot and writes the names of the vertices.
+  binary_snapshot_writer_t writer(sizeof(EdgeOffset));
+  if( !writer.open(snapshot_filename) )
+  {
+    std::cerr << "ERROR: Could not open file: " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+  writer.write_section(header_t::names_arena_section, Name2ID.arena.data(), Name2ID.arena.size());
+  writer.write_section(header_t::names_offsets_section, Name2ID.offsets.data(), Name2ID.offsets.size());
+  writer.write_section(header_t::names_slots_section, Name2ID.index.slots.data(), Name2ID.index.slots.size());
+  writer.write_section(header_t::names_hashes_section, Name2ID.index.hashes.data(), Name2ID.index.hashes.size());
+
+  // Merges the runs sorted by source into the edgelist and counts the degrees (the runs are first
+  //   merged into fewer runs if needed).
+  int nb_vertices = g_prop.nb_vertices;
+  std::size_t block_size = reduce_edge_runs(run_filenames[OutDegreeIdx], nb_edges_in_memory);
+  reduce_edge_runs(run_filenames[InDegreeIdx], nb_edges_in_memory);
+  std::vector<EdgeOffset> offsets[2];
+  offsets[InDegreeIdx].resize(nb_vertices + 1, 0);
+  offsets[OutDegreeIdx].resize(nb_vertices + 1, 0);
+  uint64_t nb_edges = 0;
+  edge_run_merger_t merger;
+  if( !merger.open(run_filenames[OutDegreeIdx], block_size) )
+  {
+    std::cerr << "ERROR: Could not read the temporary files of " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+  std::vector< std::pair<int, int> > output_block;
+  output_block.reserve(block_size);
+  std::pair<int, int> edge;
+  writer.begin_section(header_t::edges_section);
+  while( merger.next(edge) )
+  {
+    offsets[OutDegreeIdx][edge.first + 1] += 1;
+    offsets[InDegreeIdx][edge.second + 1] += 1;
+    output_block.push_back(edge);
+    if(output_block.size() == block_size)
+    {
+      writer.write(&output_block[0], output_block.size() * sizeof(edge));
+      output_block.clear();
+    }
+    ++nb_edges;
+  }
+  if(!output_block.empty())
+  {
+    writer.write(&output_block[0], output_block.size() * sizeof(edge));
+  }
+  writer.end_section(header_t::edges_section);
+  merger.close();
+  if(nb_edges > static_cast<uint64_t>(std::numeric_limits<EdgeOffset>::max()))
+  {
+    std::cerr << "ERROR: The graph has too many edges to be indexed by " << 8 * sizeof(EdgeOffset) << "-bit edge offsets (see large_directed_graph_t)." << std::endl;
+    std::terminate();
+  }
+
+  // Writes the adjacency list (the runs are merged once more to extract the neighbours).
+  for(int idx(0); idx<2; ++idx)
+  {
+    for(int v(0); v<nb_vertices; ++v)
+    {
+      offsets[idx][v + 1] += offsets[idx][v];
+    }
+  }
+  writer.write_section(header_t::in_offsets_section, &offsets[InDegreeIdx][0], nb_vertices + 1);
+  writer.begin_section(header_t::in_neighbors_section);
+  write_merged_neighbors(run_filenames[InDegreeIdx], block_size, writer);
+  writer.end_section(header_t::in_neighbors_section);
+  writer.write_section(header_t::out_offsets_section, &offsets[OutDegreeIdx][0], nb_vertices + 1);
+  writer.begin_section(header_t::out_neighbors_section);
+  write_merged_neighbors(run_filenames[OutDegreeIdx], block_size, writer);
+  writer.end_section(header_t::out_neighbors_section);
+
+  // Completes the header, closes the file and deletes the runs.
+  if( !writer.close(nb_vertices, nb_edges) )
+  {
+    std::cerr << "ERROR: Could not write file: " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+  for(int idx(0); idx<2; ++idx)
+  {
+    for(int r(0), rr(run_filenames[idx].size()); r<rr; ++r)
+    {
+      std::remove(run_filenames[idx][r].c_str());
+    }
+  }
+
+  // Uses the snapshot in place.
+  open_binary_snapshot(snapshot_filename);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::spill_edge_runs(std::vector< std::pair<int, int> >& edges, const std::string& prefix, std::vector<std::string> run_filenames[2])
+{
+  // Names of the runs.
+  std::string filename = prefix + ".run";
+  append_integer(filename, run_filenames[OutDegreeIdx].size());
+  run_filenames[OutDegreeIdx].push_back(filename + ".out");
+  run_filenames[InDegreeIdx].push_back(filename + ".in");
+
+  // Writes the edges sorted by source, and then by target (as pairs (target, source)).
+  bool is_written = write_edge_run(run_filenames[OutDegreeIdx].back(), edges);
+  for(EdgeOffset e(0), ee(edges.size()); e<ee; ++e)
+  {
+    std::swap(edges[e].first, edges[e].second);
+  }
+  is_written = write_edge_run(run_filenames[InDegreeIdx].back(), edges) && is_written;
+  if(!is_written)
+  {
+    std::cerr << "ERROR: Could not write the temporary file " << filename << "." << std::endl;
+    std::terminate();
+  }
+  edges.clear();
+}
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::initialization()
+template<typename EdgeOffset>
+std::size_t pgl::basic_directed_graph_t<EdgeOffset>::reduce_edge_runs(std::vector<std::string>& filenames, std::size_t nb_edges_in_memory)
 {
-  // Available vertex properties.
-  available_vertex_prop.insert("in-degree");
-  available_vertex_prop.insert("out-degree");
-  available_vertex_prop.insert("reciprocal_degree");
-  available_vertex_prop.insert("reciprocity_jaccard");
-  available_vertex_prop.insert("reciprocity_ratio");
-  available_vertex_prop.insert("undir_local_clust");
-  // Available vertex integer properties.
-  available_vertex_integer_prop.insert("in-degree");
-  available_vertex_integer_prop.insert("out-degree");
-  // Headers for vertex properties.
-  v_prop_header["in-degree"]  = "InDeg";
-  v_prop_header["out-degree"] = "OutDeg";
-  v_prop_header["reciprocal_degree"] = "RecDeg";
-  v_prop_header["reciprocity_jaccard"] = "ReciproJacc";
-  v_prop_header["reciprocity_ratio"] = "ReciproRatio";
-  v_prop_header["undir_local_clust"] = "UnLocalClust";
-  // Graph properties.
-  g_prop["nb_vertices"] = 0;
-  g_prop["nb_edges"] = 0;
-  g_prop["density"] = 0;
-  // Graph properties initialized to "impossible" values to check if it has been computed.
-  g_prop["nb_reciprocal_edges"] = -1;
-  g_prop["reciprocity_ratio"] = -1;
-  g_prop["reciprocity_stat"] = -1;
-  g_prop["nb_triangles"] = -1;
+  // Number of runs that can be merged at once (one block is kept for the output).
+  std::size_t max_nb_runs = std::max<std::size_t>(2, nb_edges_in_memory / min_edge_block_size - 1);
+
+  // Merges groups of runs until there are few enough of them.
+  for(int pass(0); filenames.size() > max_nb_runs; ++pass)
+  {
+    std::vector<std::string> merged_filenames;
+    for(std::size_t first(0); first<filenames.size(); first+=max_nb_runs)
+    {
+      std::vector<std::string> group(filenames.begin() + first, filenames.begin() + std::min(first + max_nb_runs, filenames.size()));
+      std::string filename = filenames[first] + ".merge";
+      append_integer(filename, pass);
+      merged_filenames.push_back(filename);
+
+      // Merges the group into a new run.
+      std::size_t block_size = nb_edges_in_memory / (group.size() + 1);
+      edge_run_merger_t merger;
+      std::FILE* file = std::fopen(filename.c_str(), "wb");
+      if( file == 0 || !merger.open(group, block_size) )
+      {
+        std::cerr << "ERROR: Could not merge the temporary files into " << filename << "." << std::endl;
+        std::terminate();
+      }
+      bool is_written = true;
+      std::vector< std::pair<int, int> > output_block;
+      output_block.reserve(block_size);
+      std::pair<int, int> edge;
+      while( merger.next(edge) )
+      {
+        output_block.push_back(edge);
+        if(output_block.size() == block_size)
+        {
+          is_written = std::fwrite(&output_block[0], sizeof(edge), output_block.size(), file) == output_block.size() && is_written;
+          output_block.clear();
+        }
+      }
+      if(!output_block.empty())
+      {
+        is_written = std::fwrite(&output_block[0], sizeof(edge), output_block.size(), file) == output_block.size() && is_written;
+      }
+      merger.close();
+      if( (std::fclose(file) != 0) || !is_written )
+      {
+        std::cerr << "ERROR: Could not write the temporary file " << filename << "." << std::endl;
+        std::terminate();
+      }
+      for(std::size_t r(0); r<group.size(); ++r)
+      {
+        std::remove(group[r].c_str());
+      }
+    }
+    filenames.swap(merged_filenames);
+  }
 
+  // Size of the blocks with which the remaining runs are merged (one block is kept for the output).
+  return nb_edges_in_memory / (filenames.size() + 1);
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// Structure containing the desired method to compared strings (put shorter ones before longer ones).
-struct compare_names_directed_graph_t
+template<typename EdgeOffset>
+uint64_t pgl::basic_directed_graph_t<EdgeOffset>::write_merged_neighbors(const std::vector<std::string>& filenames, std::size_t block_size, binary_snapshot_writer_t& writer)
 {
-  bool operator()(const std::pair<std::string, int>& lhs, const std::pair<std::string, int>& rhs) const
+  edge_run_merger_t merger;
+  if( !merger.open(filenames, block_size) )
   {
-    if(lhs.first.size() == rhs.first.size())
+    std::cerr << "ERROR: Could not read the temporary file " << filenames[0] << "." << std::endl;
+    std::terminate();
+  }
+  uint64_t nb_edges = 0;
+  std::vector<int> output_block;
+  output_block.reserve(block_size);
+  std::pair<int, int> edge;
+  while( merger.next(edge) )
+  {
+    output_block.push_back(edge.second);
+    if(output_block.size() == block_size)
+    {
+      writer.write(&output_block[0], output_block.size() * sizeof(int));
+      output_block.clear();
+    }
+    ++nb_edges;
+  }
+  if(!output_block.empty())
+  {
+    writer.write(&output_block[0], output_block.size() * sizeof(int));
+  }
+  return nb_edges;
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::parse_edgelist_chunk(const char* first, const char* last, name_view_table_t& names, std::vector< std::pair<int, int> >& edges)
+{
+  // Tokens (pointers into the mapped file).
+  const char *name1, *name2;
+  int length1, length2;
+
+  // Reads the chunk line by line (skips empty lines, lines of comment, lines with a single name and
+  //   self-loops).
+  text_scanner_t scanner(first, last);
+  while( scanner.next_line() )
+  {
+    if( !scan_edge(scanner, name1, length1, name2, length2) )
+    {
+      continue;
+    }
+    // Adds the edge (the source vertex is identified first, as in add_edge).
+    int v1 = names.insert(name1, length1);
+    int v2 = names.insert(name2, length2);
+    edges.push_back(std::make_pair(v1, v2));
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::parse_vertex_properties_chunk(const char* first, const char* last, const std::vector<int>& usecols, std::vector<name_ref_t>& names, std::vector<double>& values)
+{
+  // Number of columns to read on each line.
+  int nb_specs = usecols.size();
+  int nb_columns = *std::max_element(usecols.begin(), usecols.end()) + 1;
+  // Tokens of the current line (pointers into the mapped file).
+  std::vector<const char*> tokens(nb_columns);
+  std::vector<int> lengths(nb_columns);
+
+  // Reads the chunk line by line.
+  text_scanner_t scanner(first, last);
+  while( scanner.next_line() )
+  {
+    // Skips empty lines and lines of comment.
+    if( !scanner.next_token(tokens[0], lengths[0]) || tokens[0][0] == '#' )
+    {
+      continue;
+    }
+    // Extracts the tokens up to the last requested column.
+    int nb_tokens = 1;
+    while(nb_tokens < nb_columns && scanner.next_token(tokens[nb_tokens], lengths[nb_tokens]))
+    {
+      ++nb_tokens;
+    }
+    // Stores the name and the values (missing values are set to 0).
+    names.push_back(name_ref_t(tokens[0], lengths[0]));
+    for(int s(0); s<nb_specs; ++s)
+    {
+      values.push_back( (usecols[s] < nb_tokens) ? parse_number(tokens[usecols[s]], lengths[usecols[s]]) : 0 );
+    }
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::load_vertices_properties(std::string prop_filename, int usecol, std::string prop, std::string prop_header, bool ignore_unknown_vertices)
+{
+  load_vertices_properties(prop_filename, std::vector<vertex_property_spec_t>(1, vertex_property_spec_t(usecol, prop, prop_header)), ignore_unknown_vertices);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::load_vertices_properties(std::string prop_filename, const std::vector<vertex_property_spec_t>& specs, bool ignore_unknown_vertices)
+{
+  // Number of properties to load.
+  int nb_specs = specs.size();
+  if(nb_specs == 0)
+  {
+    return;
+  }
+
+  // Maps the file in memory and terminates if the operation did not succeed.
+  mapped_file_t prop_file;
+  if( !prop_file.open(prop_filename) )
+  {
+    std::cerr << "Could not open file: " << prop_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  std::vector<int> usecols(nb_specs);
+  std::vector<vertex_column_t*> columns(nb_specs);
+  for(int s(0); s<nb_specs; ++s)
+  {
+    if(specs[s].usecol < 1)
+    {
+      std::cerr << "ERROR: Invalid column " << specs[s].usecol << " for vertex property " << specs[s].prop << "." << std::endl;
+      std::terminate();
+    }
+    add_new_vertex_property(specs[s].prop, specs[s].prop_header);
+    usecols[s] = specs[s].usecol;
+    columns[s] = &v_prop[specs[s].prop];
+  }
+  // ===============================================================================================
+
+  // Splits the file into chunks of whole lines (one per thread) and parses them in parallel.
+  const char* first = prop_file.begin();
+  const char* last = prop_file.end();
+  int nb_chunks = std::max(1, std::min<int>(max_nb_threads(), prop_file.size() / min_edgelist_chunk_size));
+  std::vector<const char*> chunk_bounds(nb_chunks + 1, last);
+  chunk_bounds[0] = first;
+  for(int c(1); c<nb_chunks; ++c)
+  {
+    const char* pos = std::max(chunk_bounds[c - 1], first + (prop_file.size() / nb_chunks) * c);
+    const char* eol = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+    chunk_bounds[c] = (eol == 0) ? last : eol + 1;
+  }
+  std::vector< std::vector<name_ref_t> > chunk_names(nb_chunks);
+  std::vector< std::vector<double> > chunk_values(nb_chunks);
+  PGL_OMP(parallel for schedule(static, 1))
+  for(int c = 0; c < nb_chunks; ++c)
+  {
+    parse_vertex_properties_chunk(chunk_bounds[c], chunk_bounds[c + 1], usecols, chunk_names[c], chunk_values[c]);
+  }
+
+  // Assigns the values in the order of the lines (a vertex appearing more than once keeps its last
+  //   values), and may ignore unknown vertices.
+  std::vector<bool> is_integer(nb_specs, true);
+  double dummy;
+  for(int c(0); c<nb_chunks; ++c)
+  {
+    const double* values = chunk_values[c].empty() ? 0 : &chunk_values[c][0];
+    for(int r(0), rr(chunk_names[c].size()); r<rr; ++r, values+=nb_specs)
+    {
+      int idx = add_vertex(chunk_names[c][r].data, chunk_names[c][r].length, ignore_unknown_vertices);
+      if(idx == g_prop.nb_vertices)
+      {
+        continue;
+      }
+      for(int s(0); s<nb_specs; ++s)
+      {
+        if(static_cast<int>(columns[s]->size()) == idx)
+        {
+          columns[s]->push_back(values[s]);
+        }
+        else
+        {
+          columns[s]->set(idx, values[s]);
+        }
+        if( is_integer[s] && (std::modf(values[s], &dummy) != 0) )
+        {
+          is_integer[s] = false;
+        }
+      }
+    }
+    std::vector<name_ref_t>().swap(chunk_names[c]);
+    std::vector<double>().swap(chunk_values[c]);
+  }
+
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  for(int s(0); s<nb_specs; ++s)
+  {
+    if(is_integer[s])
+    {
+      available_vertex_integer_prop.insert(specs[s].prop);
+      // Stores integer values on 32 bits when possible.
+      const double* values = columns[s]->data<double>();
+      bool fits_int32 = true;
+      for(int v(0), vv(columns[s]->size()); v<vv && fits_int32; ++v)
+      {
+        fits_int32 = values[v] >= std::numeric_limits<int32_t>::min() && values[v] <= std::numeric_limits<int32_t>::max();
+      }
+      if(fits_int32)
+      {
+        columns[s]->convert(column_int32);
+      }
+    }
+  }
+  // ===============================================================================================
+}
+
+
+
+
+
+
+
+
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// 3. OUTPUT
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::estimate_properties_from_edgelist_file(std::string edgelist_filename, int sample_size, uint64_t seed)
+{
+  // Sampled pairs of vertices (ordered by hash) with the directions of their edges (see
+  //   edge_direction_t, seen from the vertex with the smallest ID).
+  typedef std::map< std::pair< uint64_t, std::pair<int, int> >, int > sample_t;
+
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  *this = basic_directed_graph_t();
+  // ===============================================================================================
+
+  if(sample_size < 4)
+  {
+    std::cerr << "ERROR: The sample must contain at least 4 pairs of vertices." << std::endl;
+    std::terminate();
+  }
+
+  // Maps the file in memory and terminates if the operation did not succeed.
+  mapped_file_t edgelist_file;
+  if( !edgelist_file.open(edgelist_filename) )
+  {
+    std::cerr << "ERROR: Could not open file: " << edgelist_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // Keeps the sample_size pairs of connected vertices with the smallest hashes (bottom-k sample).
+  //   The hash only depends on the pair, hence a pair enters the sample the first time it is seen
+  //   (if ever) and every subsequent edge between its vertices (reciprocal edge or multiedge) is
+  //   recorded as long as it stays in the sample.
+  sample_t sample;
+  uint64_t salt = splitmix64(seed);
+  uint64_t threshold = std::numeric_limits<uint64_t>::max();
+  bool is_saturated = false;
+  const char *name1, *name2;
+  int length1, length2;
+  text_scanner_t scanner(edgelist_file.begin(), edgelist_file.end());
+  while( scanner.next_line() )
+  {
+    if( !scan_edge(scanner, name1, length1, name2, length2) )
+    {
+      continue;
+    }
+    int v1 = add_vertex(name1, length1, false);
+    int v2 = add_vertex(name2, length2, false);
+    std::pair<int, int> vertex_pair = (v1 < v2) ? std::make_pair(v1, v2) : std::make_pair(v2, v1);
+    uint64_t hash = splitmix64(salt ^ ((static_cast<uint64_t>(vertex_pair.first) << 32) | static_cast<uint32_t>(vertex_pair.second)));
+    if(hash > threshold)
+    {
+      continue;
+    }
+    std::pair<sample_t::iterator, bool> entry = sample.insert(std::make_pair(std::make_pair(hash, vertex_pair), 0));
+    entry.first->second |= (v1 < v2) ? edge_to_neighbour : edge_from_neighbour;
+    if(static_cast<int>(sample.size()) > sample_size)
+    {
+      sample.erase(--sample.end());
+      threshold = (--sample.end())->first.first;
+      is_saturated = true;
+    }
+  }
+  edgelist_file.close();
+
+  // Once the sample is saturated, the pair with the largest hash is discarded and every other pair
+  //   has been sampled independently with a probability given by this hash.
+  double p = 1;
+  if(is_saturated)
+  {
+    sample_t::iterator last = --sample.end();
+    p = std::ldexp(static_cast<double>(last->first.first), -64);
+    sample.erase(last);
+  }
+
+  // Builds the adjacency list of the sample, with the directions of the edges.
+  int nb_vertices = g_prop.nb_vertices;
+  std::vector< std::pair< std::pair<int, int>, int > > entries;
+  entries.reserve(2 * sample.size());
+  for(sample_t::iterator it = sample.begin(), end = sample.end(); it!=end; ++it)
+  {
+    const std::pair<int, int>& vertex_pair = it->first.second;
+    entries.push_back(std::make_pair(vertex_pair, it->second));
+    entries.push_back(std::make_pair(std::make_pair(vertex_pair.second, vertex_pair.first), reverse_directions(it->second)));
+  }
+  sample_t().swap(sample);
+  std::sort(entries.begin(), entries.end());
+  int nb_entries = entries.size();
+  std::vector<int> offsets(nb_vertices + 1, 0);
+  std::vector<int> neighbors(nb_entries);
+  std::vector<unsigned char> directions(nb_entries);
+  for(int e(0); e<nb_entries; ++e)
+  {
+    offsets[entries[e].first.first + 1] += 1;
+    neighbors[e] = entries[e].first.second;
+    directions[e] = entries[e].second;
+  }
+  std::vector< std::pair< std::pair<int, int>, int > >().swap(entries);
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  // Counts the edges, the reciprocal edges and the wedges (pairs of adjacent edges) of the sample.
+  //   Two distinct wedges share at most one pair of vertices, and a pair u-v is shared by
+  //   d_u + d_v - 2 wedges.
+  int64_t nb_sampled_edges = 0, nb_sampled_reciprocal_pairs = 0, nb_sampled_wedges = 0, nb_sampled_vertices_deg_1 = 0;
+  double sum_sq_edges = 0, nb_wedge_pairs = 0;
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    int64_t d = offsets[v + 1] - offsets[v];
+    nb_sampled_wedges += d * (d - 1) / 2;
+    nb_sampled_vertices_deg_1 += (d == 1) ? 1 : 0;
+    for(int e(offsets[v]), ee(offsets[v + 1]); e<ee; ++e)
+    {
+      int w = neighbors[e];
+      if(v < w)
+      {
+        int nb_edges_in_pair = (directions[e] == (edge_to_neighbour | edge_from_neighbour)) ? 2 : 1;
+        nb_sampled_edges += nb_edges_in_pair;
+        nb_sampled_reciprocal_pairs += nb_edges_in_pair - 1;
+        sum_sq_edges += nb_edges_in_pair * nb_edges_in_pair;
+        double c = d + (offsets[w + 1] - offsets[w]) - 2;
+        nb_wedge_pairs += c * (c - 1);
+      }
+    }
+  }
+
+  // Enumerates the triangles v1 < v2 < v3 of the sample, counting the triangles containing each
+  //   pair (indexed by its entry from the vertex with the smallest ID).
+  int64_t nb_sampled_triangles = 0;
+  int64_t sampled_spect[nb_triangle_configurations];
+  std::fill(sampled_spect, sampled_spect + nb_triangle_configurations, 0);
+  std::vector<int> nb_triangles_per_pair(nb_entries, 0);
+  std::vector<int> common;
+  for(int v1(0); v1<nb_vertices; ++v1)
+  {
+    const int* first1 = &neighbors[0] + offsets[v1];
+    const int* last1 = &neighbors[0] + offsets[v1 + 1];
+    for(const int* it12 = std::upper_bound(first1, last1, v1); it12 != last1; ++it12)
+    {
+      int v2 = *it12;
+      int e12 = it12 - &neighbors[0];
+      const int* first2 = std::upper_bound(&neighbors[0] + offsets[v2], &neighbors[0] + offsets[v2 + 1], v2);
+      const int* last2 = &neighbors[0] + offsets[v2 + 1];
+      common.resize(std::min(last1 - (it12 + 1), last2 - first2));
+      if(common.empty())
+      {
+        continue;
+      }
+      int nb_common = intersect_sorted(it12 + 1, last1 - (it12 + 1), first2, last2 - first2, &common[0]);
+      for(int i(0); i<nb_common; ++i)
+      {
+        int e13 = std::lower_bound(it12 + 1, last1, common[i]) - &neighbors[0];
+        int e23 = std::lower_bound(first2, last2, common[i]) - &neighbors[0];
+        int configuration = triangle_configuration(directions[e12] | (directions[e23] << 2) | (reverse_directions(directions[e13]) << 4));
+        sampled_spect[configuration] += 1;
+        nb_sampled_triangles += 1;
+        nb_triangles_per_pair[e12] += 1;
+        nb_triangles_per_pair[e13] += 1;
+        nb_triangles_per_pair[e23] += 1;
+      }
+    }
+  }
+  // Number of ordered pairs of sampled triangles sharing a pair of vertices.
+  double nb_triangle_pairs = 0;
+  for(int e(0); e<nb_entries; ++e)
+  {
+    nb_triangle_pairs += nb_triangles_per_pair[e] * (nb_triangles_per_pair[e] - 1.0);
+  }
+
+  // Horvitz-Thompson estimators: a set of k pairs of vertices is sampled with probability p^k.
+  //   The variances account for the covariances between the triangles (wedges) sharing a pair, and
+  //   include one pseudo-observation such that the intervals do not collapse when nothing has been
+  //   sampled.
+  double p2 = p * p, p3 = p2 * p, p4 = p2 * p2, p6 = p3 * p3;
+  double nb_edges_hat = nb_sampled_edges / p;
+  double var_nb_edges = (sum_sq_edges + 1) * (1 - p) / p2;
+  double nb_reciprocal_edges_hat = 2 * nb_sampled_reciprocal_pairs / p;
+  double var_nb_reciprocal_edges = 4 * (nb_sampled_reciprocal_pairs + 1) * (1 - p) / p2;
+  double nb_triangles_hat = nb_sampled_triangles / p3;
+  double var_nb_triangles = ((nb_sampled_triangles + 1) * (1 - p3) + nb_triangle_pairs * (1 - p)) / p6;
+  double nb_wedges_hat = nb_sampled_wedges / p2;
+  double var_nb_wedges = ((nb_sampled_wedges + 1) * (1 - p2) + nb_wedge_pairs * (1 - p)) / p4;
+
+  // ===============================================================================================
+  // Updates the properties of the graph (same expressions as in compute_reciprocity and
+  //   survey_triangles).
+  g_prop.nb_edges = static_cast<int64_t>(nb_edges_hat + 0.5);
+  compute_density();
+  g_prop.nb_reciprocal_edges = static_cast<int64_t>(nb_reciprocal_edges_hat + 0.5);
+  g_prop.reciprocity_ratio = nb_reciprocal_edges_hat / nb_edges_hat;
+  g_prop.reciprocity_stat = (g_prop.reciprocity_ratio - g_prop.density) / (1 - g_prop.density);
+  g_prop.nb_triangles = static_cast<int64_t>(nb_triangles_hat + 0.5);
+  g_prop.total_nb_triads = static_cast<int64_t>(nb_wedges_hat + 0.5);
+  g_prop.undir_global_clust = 3 * nb_triangles_hat / nb_wedges_hat;
+  g_prop.nb_vertices_undir_deg_0 = 0;
+  int valid_stats[] = { graph_stats_t::stat_nb_edges, graph_stats_t::stat_density, graph_stats_t::stat_nb_reciprocal_edges,
+                        graph_stats_t::stat_reciprocity_ratio, graph_stats_t::stat_reciprocity_stat, graph_stats_t::stat_nb_triangles,
+                        graph_stats_t::stat_total_nb_triads, graph_stats_t::stat_undir_global_clust, graph_stats_t::stat_nb_vertices_undir_deg_0 };
+  for(int i(0); i<9; ++i)
+  {
+    g_prop.validate(static_cast<graph_stats_t::stat_t>(valid_stats[i]));
+  }
+  triangle_spect.clear();
+  for(int c(0); c<nb_triangle_configurations; ++c)
+  {
+    triangle_spect[triangle_configuration_name(c)] = static_cast<int64_t>(sampled_spect[c] / p3 + 0.5);
+  }
+  if(!is_saturated)
+  {
+    // Every pair has been kept: the degrees are known.
+    g_prop.nb_vertices_undir_deg_1 = nb_sampled_vertices_deg_1;
+    g_prop.validate(graph_stats_t::stat_nb_vertices_undir_deg_1);
+  }
+  else
+  {
+    // Flags the estimates and computes their confidence intervals (the intervals of the ratios are
+    //   conservatively obtained from the bounds of the counts).
+    double nb_pairs = static_cast<double>(g_prop.nb_vertices) * (g_prop.nb_vertices - 1);
+    double edges_lower, edges_upper, reciprocal_lower, reciprocal_upper, triangles_lower, triangles_upper, wedges_lower, wedges_upper;
+    normal_confidence_interval(nb_edges_hat, var_nb_edges, nb_sampled_edges, edges_lower, edges_upper);
+    g_prop.set_estimate(graph_stats_t::stat_nb_edges, edges_lower, edges_upper);
+    double density_lower = edges_lower / nb_pairs, density_upper = edges_upper / nb_pairs;
+    g_prop.set_estimate(graph_stats_t::stat_density, density_lower, density_upper);
+    normal_confidence_interval(nb_reciprocal_edges_hat, var_nb_reciprocal_edges, 2 * nb_sampled_reciprocal_pairs, reciprocal_lower, reciprocal_upper);
+    g_prop.set_estimate(graph_stats_t::stat_nb_reciprocal_edges, reciprocal_lower, reciprocal_upper);
+    double ratio_lower = reciprocal_lower / edges_upper;
+    double ratio_upper = (edges_lower > 0) ? std::min(1.0, reciprocal_upper / edges_lower) : 1;
+    g_prop.set_estimate(graph_stats_t::stat_reciprocity_ratio, ratio_lower, ratio_upper);
+    g_prop.set_estimate(graph_stats_t::stat_reciprocity_stat, (ratio_lower - density_upper) / (1 - density_upper), (ratio_upper - density_lower) / (1 - density_lower));
+    normal_confidence_interval(nb_triangles_hat, var_nb_triangles, nb_sampled_triangles, triangles_lower, triangles_upper);
+    g_prop.set_estimate(graph_stats_t::stat_nb_triangles, triangles_lower, triangles_upper);
+    normal_confidence_interval(nb_wedges_hat, var_nb_wedges, nb_sampled_wedges, wedges_lower, wedges_upper);
+    g_prop.set_estimate(graph_stats_t::stat_total_nb_triads, wedges_lower, wedges_upper);
+    double clust_lower = 3 * triangles_lower / wedges_upper;
+    double clust_upper = (wedges_lower > 0) ? std::min(1.0, 3 * triangles_upper / wedges_lower) : 1;
+    g_prop.set_estimate(graph_stats_t::stat_undir_global_clust, clust_lower, clust_upper);
+  }
+  // ===============================================================================================
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::save_binary_snapshot(std::string snapshot_filename)
+{
+  typedef binary_snapshot_header_t header_t;
+
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Ensures that the adjacency list has been built (compressed lists are decoded as they are
+  //   written).
+  bool is_compressed = is_adjacency_list_compressed();
+  if(adjacency_list.size() != nb_vertices && !is_compressed)
+  {
+    build_adjacency_list();
+  }
+
+  // Opens the file and terminates if the operation did not succeed.
+  binary_snapshot_writer_t writer(sizeof(EdgeOffset));
+  if( !writer.open(snapshot_filename) )
+  {
+    std::cerr << "ERROR: Could not open file: " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+
+  // Writes the sections.
+  uint64_t nb_edges = edgelist.size();
+  writer.write_section(header_t::names_arena_section, Name2ID.arena.data(), Name2ID.arena.size());
+  writer.write_section(header_t::names_offsets_section, Name2ID.offsets.data(), Name2ID.offsets.size());
+  writer.write_section(header_t::names_slots_section, Name2ID.index.slots.data(), Name2ID.index.slots.size());
+  writer.write_section(header_t::names_hashes_section, Name2ID.index.hashes.data(), Name2ID.index.hashes.size());
+  if(!is_compressed)
+  {
+    edgelist_iterator edges = edgelist_begin();
+    writer.write_section(header_t::edges_section, edges, edgelist.size());
+    writer.write_section(header_t::in_offsets_section, adjacency_list.offsets[InDegreeIdx].data(), adjacency_list.offsets[InDegreeIdx].size());
+    writer.write_section(header_t::in_neighbors_section, adjacency_list.neighbors[InDegreeIdx].data(), adjacency_list.neighbors[InDegreeIdx].size());
+    writer.write_section(header_t::out_offsets_section, adjacency_list.offsets[OutDegreeIdx].data(), adjacency_list.offsets[OutDegreeIdx].size());
+    writer.write_section(header_t::out_neighbors_section, adjacency_list.neighbors[OutDegreeIdx].data(), adjacency_list.neighbors[OutDegreeIdx].size());
+  }
+  // Decodes the compressed lists of neighbours vertex by vertex (the edges are the out-neighbours
+  //   of the vertices, in order).
+  else
+  {
+    std::vector<int> buffer;
+    std::vector< std::pair<int, int> > edges;
+    writer.begin_section(header_t::edges_section);
+    for(int v(0); v<nb_vertices; ++v)
     {
-      if(lhs.first == rhs.first)
-      {
-        return lhs.second < rhs.second;
-      }
-      else
+      neighbor_range_t range = neighbors(v, OutDegreeIdx, buffer);
+      edges.clear();
+      for(const int* it = range.begin(); it != range.end(); ++it)
       {
-        return lhs.first < rhs.first;
+        edges.push_back(std::make_pair(v, *it));
       }
+      writer.write(edges.empty() ? NULL : &edges[0], edges.size() * sizeof(edges[0]));
     }
-    else
+    writer.end_section(header_t::edges_section);
+    const int offsets_sections[2] = {header_t::in_offsets_section, header_t::out_offsets_section};
+    const int neighbors_sections[2] = {header_t::in_neighbors_section, header_t::out_neighbors_section};
+    for(int idx(0); idx<2; ++idx)
     {
-      return lhs.first.size() < rhs.first.size();
+      std::vector<EdgeOffset> offsets(nb_vertices + 1, 0);
+      for(int v(0); v<nb_vertices; ++v)
+      {
+        offsets[v + 1] = offsets[v] + compressed_neighbors(v, idx).size();
+      }
+      writer.write_section(offsets_sections[idx], &offsets[0], offsets.size());
+      nb_edges = offsets[nb_vertices];
+      writer.begin_section(neighbors_sections[idx]);
+      for(int v(0); v<nb_vertices; ++v)
+      {
+        neighbor_range_t range = neighbors(v, idx, buffer);
+        writer.write(range.begin(), range.size() * sizeof(int));
+      }
+      writer.end_section(neighbors_sections[idx]);
     }
   }
-};
-
-
 
-
-
-
-
-
-
-
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 0. INTERNAL MANAGMENT: GENERATING SECONDARY OBJECTS
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+  // Completes the header and closes the file.
+  if( !writer.close(nb_vertices, nb_edges) )
+  {
+    std::cerr << "ERROR: Could not write file: " << snapshot_filename << "." << std::endl;
+    std::terminate();
+  }
+}
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::build_adjacency_list()
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID, int width, bool header)
 {
+  // Stream objects.
+  std::fstream output_file;
+  // Opens the stream and terminates if the operation did not succeed.
+  output_file.open(filename.c_str(), std::fstream::out);
+  if( !output_file.is_open() )
+  {
+    std::cerr << "ERROR: Could not open file: " << filename << "." << std::endl;
+    std::terminate();
+  }
+
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
-  adjacency_list.clear();
-  adjacency_list.resize(nb_vertices, std::vector< std::vector<int> >(2));
+  int nb_vertices = g_prop.nb_vertices;
   // ===============================================================================================
 
-  // Loops over all edges.
-  int v1, v2;
-  std::set< std::pair<int, int> >::iterator it = edgelist.begin();
-  std::set< std::pair<int, int> >::iterator end = edgelist.end();
-  for(; it!=end; ++it)
+  // Number of properties.
+  int nb_props = props_id.size();
+
+  // Checks whether all properties have been extracted/computed and resolves their columns.
+  std::vector<const vertex_column_t*> columns(nb_props);
+  std::vector<bool> is_integer(nb_props);
+  for(int i(0); i<nb_props; ++i)
   {
-    // Identifies the vertices.
-    v1 = it->first;
-    v2 = it->second;
-    // Adds the percolated edge.
-    adjacency_list[v1][OutDegreeIdx].push_back(v2);
-    adjacency_list[v2][InDegreeIdx].push_back(v1);
+    is_vertex_property(props_id[i]);
+    columns[i] = &v_prop[props_id[i]];
+    is_integer[i] = is_vertex_integer_property(props_id[i], false);
+    if(columns[i]->size() != nb_vertices)
+    {
+      std::cerr << "ERROR: The property " << props_id[i] << " has not been extracted/computed." << std::endl;
+      std::terminate();
+    }
   }
-}
 
+  // Checks the type of identifier of the vertices.
+  if(vID != vID_name && vID != vID_num && vID != vID_none)
+  {
+    std::cerr << "ERROR: Unknown vertex identifier type." << std::endl;
+    std::terminate();
+  }
 
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::build_ID2Name()
-{
-  // ===============================================================================================
-  // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
+  // Orders the vertices by name (also builds ID2Name).
+  const std::vector<int>& ordered_vertices = order_vertices_by_name();
 
-  ID2Name.clear();
-  ID2Name.resize(nb_vertices);
-  // ===============================================================================================
+  // Prints the header (if required).
+  if(header)
+  {
+    int i = 0;
+    if(vID == vID_name || vID == vID_num)
+    {
+      output_file << "#" << std::setw(width - 1) << "Vertex" << " ";
+      output_file << std::setw(width) << v_prop_header[props_id[i]] << " ";
+      ++i;
+    }
+    else
+    {
+      output_file << "#" << std::setw(width - 1) << v_prop_header[props_id[i]] << " ";
+      ++i;
+    }
+    for(; i<nb_props; ++i)
+    {
+      output_file << std::setw(width) << v_prop_header[props_id[i]] << " ";
+    }
+    output_file << std::endl;
+  }
 
-  // Loops over all names.
-  std::map<std::string, int>::iterator it = Name2ID.begin();
-  std::map<std::string, int>::iterator end = Name2ID.end();
-  for(; it!=end; ++it)
+  // Prints the properties. Blocks of rows are formatted in parallel (integers as with std::fixed
+  //   and a precision of 0, other values as with std::scientific and a precision of 6), and are
+  //   then written in order with one call per block.
+  int nb_blocks = (nb_vertices + output_block_size - 1) / output_block_size;
+  int nb_blocks_per_round = 4 * max_nb_threads();
+  std::vector<std::string> blocks(nb_blocks_per_round);
+  for(int first_block(0); first_block<nb_blocks; first_block+=nb_blocks_per_round)
   {
-    ID2Name[it->second] = it->first;
+    int last_block = std::min(nb_blocks, first_block + nb_blocks_per_round);
+    PGL_OMP(parallel for schedule(dynamic, 1))
+    for(int b = first_block; b < last_block; ++b)
+    {
+      std::string& text = blocks[b - first_block];
+      text.clear();
+      char number[512];
+      for(int r(b * output_block_size), rr(std::min(nb_vertices, (b + 1) * output_block_size)); r<rr; ++r)
+      {
+        int v = ordered_vertices[r];
+        if(vID == vID_name)
+        {
+          name_ref_t name = ID2Name[v];
+          append_field(text, name.data, name.length, width);
+          text += ' ';
+        }
+        else if(vID == vID_num)
+        {
+          append_field(text, number, format_integer(number, v), width);
+          text += ' ';
+        }
+        for(int i(0); i<nb_props; ++i)
+        {
+          int length;
+          if(!is_integer[i])
+          {
+            length = format_scientific(number, columns[i]->get(v));
+          }
+          else if(columns[i]->type() == column_int32)
+          {
+            length = format_integer(number, columns[i]->data<int32_t>()[v]);
+          }
+          else if(columns[i]->type() == column_int64)
+          {
+            length = format_integer(number, columns[i]->data<int64_t>()[v]);
+          }
+          else
+          {
+            length = std::sprintf(number, "%.0f", columns[i]->get(v));
+          }
+          append_field(text, number, length, width);
+          text += ' ';
+        }
+        text += '\n';
+      }
+    }
+    for(int b(first_block); b<last_block; ++b)
+    {
+      output_file.write(blocks[b - first_block].data(), blocks[b - first_block].size());
+    }
   }
+
+  // Closes the stream.
+  output_file.close();
 }
 
 
@@ -329,118 +4736,161 @@ void pgl::directed_graph_t::build_ID2Name()
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 0. ADDING AND CHECKING THE EXISTENCE OF VERTICES AND EDGES
+// 4. DEGREE
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 
-
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-bool pgl::directed_graph_t::is_edge(int v_source, int v_target)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compute_degrees()
 {
-  return std::find(adjacency_list[v_source][OutDegreeIdx].begin(),
-                   adjacency_list[v_source][OutDegreeIdx].end(),
-                   v_target) != adjacency_list[v_source][OutDegreeIdx].end();
-}
-
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  v_prop.create("in-degree", column_int32).resize(nb_vertices, 0);
+  v_prop.create("out-degree", column_int32).resize(nb_vertices, 0);
+  int32_t* Vertex2InDegree = v_prop["in-degree"].data<int32_t>();
+  int32_t* Vertex2OutDegree = v_prop["out-degree"].data<int32_t>();
+  // ===============================================================================================
 
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-int pgl::directed_graph_t::add_vertex(std::string name_str, bool ignore_unknown_vertices)
-{
-  // Numerical ID of the vertex.
-  int v;
-  // Is the vertex new?
-  std::map< std::string, int >::iterator name_it = Name2ID.find(name_str);
-  if(name_it == Name2ID.end())
+  // Extracts the degrees from the adjacency list (if already generated).
+  if(adjacency_list.size() == nb_vertices)
   {
-    if(ignore_unknown_vertices)
+    // Loops over all vertices.
+    for(int v(0); v<nb_vertices; ++v)
     {
-      v = g_prop["nb_vertices"];
+      Vertex2InDegree[v] = in_neighbors(v).size();
+      Vertex2OutDegree[v] = out_neighbors(v).size();
     }
-    else
+  }
+  // Reads the degrees at the beginning of the compressed lists of neighbours.
+  else if(is_adjacency_list_compressed())
+  {
+    for(int v(0); v<nb_vertices; ++v)
     {
-      v = g_prop["nb_vertices"];
-      Name2ID[name_str] = v;
-      g_prop["nb_vertices"] = v + 1;
+      Vertex2InDegree[v] = compressed_neighbors(v, InDegreeIdx).size();
+      Vertex2OutDegree[v] = compressed_neighbors(v, OutDegreeIdx).size();
     }
   }
-  // If not, fetch its already assigned numerical ID.
+  // Otherwise extracts the degrees from the edgelist.
   else
   {
-    v = name_it->second;
-  }
-  // Returns the numerical ID of the vertex.
-  return v;
-}
-
-
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-bool pgl::directed_graph_t::add_edge(std::string name1_str, std::string name2_str, bool ignore_unknown_vertices)
-{
-  // Ignores self-loops.
-  if(name1_str == name2_str)
-  {
-    return false;
-  }
-
-  // Source vertex.
-  int v1 = add_vertex(name1_str, ignore_unknown_vertices);
-  if(ignore_unknown_vertices)
-  {
-    if(v1 == g_prop["nb_vertices"])
+    // Loops over all edges.
+    int v1, v2;
+    edgelist_iterator it = edgelist.begin();
+    edgelist_iterator end = edgelist.end();
+    for(; it!=end; ++it)
     {
-      return false;
+      // Identifies the vertices.
+      v1 = it->first;
+      v2 = it->second;
+      // Adds the contribution to the degree of vertices.
+      Vertex2OutDegree[v1] += 1;
+      Vertex2InDegree[v2] += 1;
     }
   }
 
-  // Target vertex.
-  int v2 = add_vertex(name2_str, ignore_unknown_vertices);
-  if(ignore_unknown_vertices)
+  // Counts the number of vertices with total degree of 0 or 1.
+  int nb_vertices_deg_0 = 0;
+  int nb_vertices_deg_1 = 0;
+  for(int v(0); v<nb_vertices; ++v)
   {
-    if(v2 == g_prop["nb_vertices"])
+    if(Vertex2OutDegree[v] == 0 && Vertex2InDegree[v] == 0)
     {
-      return false;
+      nb_vertices_deg_0 += 1;
+    }
+    else if(Vertex2OutDegree[v] == 1 && Vertex2InDegree[v] == 0)
+    {
+      nb_vertices_deg_1 += 1;
+    }
+    else if(Vertex2OutDegree[v] == 0 && Vertex2InDegree[v] == 1)
+    {
+      nb_vertices_deg_1 += 1;
     }
   }
 
-  // Adds the edge (multiedges are automatically ignored).
-  bool edge_added = (edgelist.insert(std::make_pair(v1, v2))).second;
-  if(edge_added)
-  {
-    g_prop["nb_edges"] += 1;
-  }
-  return edge_added;
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  g_prop.nb_vertices_undir_deg_0 = nb_vertices_deg_0;
+  g_prop.nb_vertices_undir_deg_1 = nb_vertices_deg_1;
+  g_prop.validate(graph_stats_t::stat_nb_vertices_undir_deg_0);
+  g_prop.validate(graph_stats_t::stat_nb_vertices_undir_deg_1);
+  // ===============================================================================================
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-bool pgl::directed_graph_t::add_edge(int v1, int v2)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compute_density()
 {
-  // Ignores self-loops.
-  if(v1 == v2)
-  {
-    return false;
-  }
+  g_prop.density = g_prop.nb_edges / (static_cast<double>(g_prop.nb_vertices) * (g_prop.nb_vertices - 1));
+  g_prop.validate(graph_stats_t::stat_density);
+}
 
-  // Does not add the edge if vertices do not exist.
-  if(v1 >= g_prop["nb_vertices"])
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compute_reciprocity()
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+
+  v_prop.create("reciprocal_degree", column_int32).resize(nb_vertices, 0);
+  int32_t* Vertex2ReciprocalDegree = v_prop["reciprocal_degree"].data<int32_t>();
+
+  v_prop.create("reciprocity_jaccard", column_double).resize(nb_vertices, 0);
+  double* Vertex2ReciprocityJaccard = v_prop["reciprocity_jaccard"].data<double>();
+
+  v_prop.create("reciprocity_ratio", column_double).resize(nb_vertices, 0);
+  double* Vertex2ReciprocityRatio = v_prop["reciprocity_ratio"].data<double>();
+  // ===============================================================================================
+
+  // Ensures that the adjacency list and the in-/out-degrees have been computed.
+  if(adjacency_list.size() != nb_vertices && !is_adjacency_list_compressed())
   {
-    return false;
+    build_adjacency_list();
   }
-  if(v2 >= g_prop["nb_vertices"])
+  if(v_prop["in-degree"].size() != nb_vertices)
   {
-    return false;
+    compute_degrees();
   }
 
-  // Adds the edge (multiedges are automatically ignored).
-  bool edge_added = (edgelist.insert(std::make_pair(v1, v2))).second;
-  if(edge_added)
+  // The reciprocal edges of a vertex are given by the intersection of its sorted lists of in- and
+  //   out-neighbors. Every reciprocal pair of edges is counted once by each of its two vertices,
+  //   which gives the number of reciprocal edges. The count is an integer such that its sum does
+  //   not depend on the scheduling.
+  long long nb_reciprocal_edges = 0;
+  PGL_OMP(parallel)
   {
-    g_prop["nb_edges"] += 1;
+    // Buffers in which the compressed lists are decoded (one per thread).
+    std::vector<int> in_buffer, out_buffer;
+    PGL_OMP(for schedule(dynamic, 1024) reduction(+:nb_reciprocal_edges))
+    for(int v = 0; v < nb_vertices; ++v)
+    {
+      neighbor_range_t in = neighbors(v, InDegreeIdx, in_buffer);
+      neighbor_range_t out = neighbors(v, OutDegreeIdx, out_buffer);
+      int reciprocal_degree = intersection_size(in.begin(), in.size(), out.begin(), out.size());
+      double total_degree = in.size() + out.size();
+      nb_reciprocal_edges += reciprocal_degree;
+      Vertex2ReciprocalDegree[v] = reciprocal_degree;
+      Vertex2ReciprocityJaccard[v] = reciprocal_degree / (total_degree - reciprocal_degree);
+      Vertex2ReciprocityRatio[v] = 2 * reciprocal_degree / total_degree;
+    }
   }
-  return edge_added;
+
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  compute_density();
+  g_prop.nb_reciprocal_edges = nb_reciprocal_edges;
+  g_prop.reciprocity_ratio = static_cast<double>(nb_reciprocal_edges) / g_prop.nb_edges;
+  g_prop.reciprocity_stat = (g_prop.reciprocity_ratio - g_prop.density) / (1 - g_prop.density);
+  g_prop.validate(graph_stats_t::stat_nb_reciprocal_edges);
+  g_prop.validate(graph_stats_t::stat_reciprocity_ratio);
+  g_prop.validate(graph_stats_t::stat_reciprocity_stat);
+  // ===============================================================================================
 }
 
 
@@ -453,386 +4903,651 @@ bool pgl::directed_graph_t::add_edge(int v1, int v2)
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 0. MANAGING VERTEX PROPERTIES
+// 5. TRIANGLES
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::build_undirected_adjacency_list(std::vector<EdgeOffset>& offsets, std::vector<int>& neighbors, std::vector<unsigned char>& directions)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Ensures that the adjacency list has been built.
+  if(adjacency_list.size() != nb_vertices && !is_adjacency_list_compressed())
+  {
+    build_adjacency_list();
+  }
+
+  // Counts the undirected neighbours.
+  offsets.assign(nb_vertices + 1, 0);
+  PGL_OMP(parallel)
+  {
+    std::vector<int> in_buffer, out_buffer;
+    PGL_OMP(for schedule(dynamic, 1024))
+    for(int v = 0; v < nb_vertices; ++v)
+    {
+      neighbor_range_t in_v = this->neighbors(v, InDegreeIdx, in_buffer);
+      neighbor_range_t out_v = this->neighbors(v, OutDegreeIdx, out_buffer);
+      offsets[v + 1] = union_size(in_v.begin(), in_v.size(), out_v.begin(), out_v.size());
+    }
+  }
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    offsets[v + 1] += offsets[v];
+  }
+
+  // Merges the in- and out-neighbourhoods.
+  neighbors.resize(offsets[nb_vertices]);
+  directions.resize(offsets[nb_vertices]);
+  PGL_OMP(parallel)
+  {
+    std::vector<int> in_buffer, out_buffer;
+    PGL_OMP(for schedule(dynamic, 1024))
+    for(int v = 0; v < nb_vertices; ++v)
+    {
+      neighbor_range_t in_v = this->neighbors(v, InDegreeIdx, in_buffer);
+      neighbor_range_t out_v = this->neighbors(v, OutDegreeIdx, out_buffer);
+      const int* in_it = in_v.begin();
+      const int* out_it = out_v.begin();
+      for(EdgeOffset k(offsets[v]); k<offsets[v + 1]; ++k)
+      {
+        if(out_it == out_v.end() || (in_it != in_v.end() && *in_it < *out_it))
+        {
+          neighbors[k] = *in_it++;
+          directions[k] = edge_from_neighbour;
+        }
+        else if(in_it == in_v.end() || *out_it < *in_it)
+        {
+          neighbors[k] = *out_it++;
+          directions[k] = edge_to_neighbour;
+        }
+        else
+        {
+          neighbors[k] = *in_it++;
+          directions[k] = edge_to_neighbour | edge_from_neighbour;
+          ++out_it;
+        }
+      }
+    }
+  }
+}
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-bool pgl::directed_graph_t::is_vertex_integer_property(std::string prop, bool exit_on_error)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::orient_by_degree(const std::vector<EdgeOffset>& offsets, const std::vector<int>& neighbors, const std::vector<unsigned char>& directions, std::vector<int>& Rank2Vertex, std::vector<EdgeOffset>& forward_offsets, std::vector<int>& forward_neighbors, std::vector<unsigned char>& forward_directions)
 {
-  bool is_not = available_vertex_integer_prop.find(prop) == available_vertex_integer_prop.end();
-  if(exit_on_error)
+  int nb_vertices = offsets.size() - 1;
+
+  // Ranks the vertices by undirected degree (ties are broken by ID).
+  std::vector< std::pair<int, int> > degree_and_vertex(nb_vertices);
+  for(int v(0); v<nb_vertices; ++v)
   {
-    if(is_not)
+    degree_and_vertex[v] = std::make_pair(offsets[v + 1] - offsets[v], v);
+  }
+  parallel_sort(degree_and_vertex);
+  Rank2Vertex.resize(nb_vertices);
+  std::vector<int> Vertex2Rank(nb_vertices);
+  for(int r(0); r<nb_vertices; ++r)
+  {
+    Rank2Vertex[r] = degree_and_vertex[r].second;
+    Vertex2Rank[degree_and_vertex[r].second] = r;
+  }
+  std::vector< std::pair<int, int> >().swap(degree_and_vertex);
+
+  // Counts the neighbours of higher rank.
+  forward_offsets.assign(nb_vertices + 1, 0);
+  PGL_OMP(parallel for schedule(dynamic, 1024))
+  for(int v = 0; v < nb_vertices; ++v)
+  {
+    int count = 0;
+    for(EdgeOffset k(offsets[v]); k<offsets[v + 1]; ++k)
     {
-      std::cerr << "ERROR: " << prop << " is not a valid vertex integer property." << std::endl;
-      std::terminate();
+      count += (Vertex2Rank[neighbors[k]] > Vertex2Rank[v]) ? 1 : 0;
+    }
+    forward_offsets[Vertex2Rank[v] + 1] = count;
+  }
+  for(int r(0); r<nb_vertices; ++r)
+  {
+    forward_offsets[r + 1] += forward_offsets[r];
+  }
+
+  // Fills the forward neighbourhoods, sorted by rank (the direction of the edges follows).
+  forward_neighbors.resize(forward_offsets[nb_vertices]);
+  forward_directions.resize(forward_offsets[nb_vertices]);
+  PGL_OMP(parallel)
+  {
+    std::vector<uint64_t> keys;
+    PGL_OMP(for schedule(dynamic, 1024))
+    for(int v = 0; v < nb_vertices; ++v)
+    {
+      int r = Vertex2Rank[v];
+      keys.clear();
+      for(EdgeOffset k(offsets[v]); k<offsets[v + 1]; ++k)
+      {
+        if(Vertex2Rank[neighbors[k]] > r)
+        {
+          keys.push_back((static_cast<uint64_t>(Vertex2Rank[neighbors[k]]) << 2) | directions[k]);
+        }
+      }
+      std::sort(keys.begin(), keys.end());
+      for(int k(0), kk(keys.size()); k<kk; ++k)
+      {
+        forward_neighbors[forward_offsets[r] + k] = keys[k] >> 2;
+        forward_directions[forward_offsets[r] + k] = keys[k] & 3;
+      }
     }
   }
-  return !is_not;
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::is_vertex_property(std::string prop)
+template<typename EdgeOffset>
+template<typename Visitor>
+void pgl::basic_directed_graph_t<EdgeOffset>::enumerate_triangles(std::vector<Visitor*>& thread_visitors, triangle_engine_t engine, std::vector<EdgeOffset>& undirected_offsets)
 {
-  if(available_vertex_prop.find(prop) == available_vertex_prop.end())
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  int nb_vertices = g_prop.nb_vertices;
+  // ===============================================================================================
+
+  // Variables.
+  int nb_blocks = (nb_vertices + triangle_block_size - 1) / triangle_block_size;
+
+  // Undirected adjacency list (with the direction of the edges).
+  std::vector<int> undirected_neighbors;
+  std::vector<unsigned char> undirected_directions;
+  build_undirected_adjacency_list(undirected_offsets, undirected_neighbors, undirected_directions);
+
+  // Orients the edges according to the degree of the vertices.
+  std::vector<int> Rank2Vertex, forward_neighbors;
+  std::vector<EdgeOffset> forward_offsets;
+  std::vector<unsigned char> forward_directions;
+  if(engine == triangles_by_degree_order)
   {
-    std::cerr << "ERROR: " << prop << " is not a valid vertex property." << std::endl;
-    std::terminate();
+    orient_by_degree(undirected_offsets, undirected_neighbors, undirected_directions, Rank2Vertex, forward_offsets, forward_neighbors, forward_directions);
   }
-}
 
+  // Lists of sorted neighbours visited by the chosen engine: the neighbours of higher ID for
+  //   triangles_by_vertex_order and the forward neighbours for triangles_by_degree_order.
+  const std::vector<EdgeOffset>& list_offsets = (engine == triangles_by_degree_order) ? forward_offsets : undirected_offsets;
+  const int* list_neighbors = (engine == triangles_by_degree_order) ? (forward_neighbors.empty() ? NULL : &forward_neighbors[0]) : (undirected_neighbors.empty() ? NULL : &undirected_neighbors[0]);
+  const unsigned char* list_directions = (engine == triangles_by_degree_order) ? (forward_directions.empty() ? NULL : &forward_directions[0]) : (undirected_directions.empty() ? NULL : &undirected_directions[0]);
 
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::add_new_vertex_integer_property(std::string prop, std::string prop_header)
-{
-  add_new_vertex_property(prop, prop_header);
-  if(available_vertex_integer_prop.find(prop) != available_vertex_integer_prop.end())
+  // Finds all the triangles. Blocks of vertices are distributed dynamically among the threads since
+  //   the amount of work varies greatly from one vertex to another.
+  PGL_OMP(parallel num_threads(thread_visitors.size()))
   {
-    std::cerr << "ERROR: Vertex integer property " << prop << " already exists." << std::endl;
-    std::terminate();
+    // Variables.
+    int v1, v2, d1, d2, d3;
+    triangle_t triangle;
+    int directions[3];
+    // Common neighbours of vertices v1 and v2.
+    std::vector<int> intersection;
+    // Visitor of the thread.
+    Visitor& visitor = *thread_visitors[thread_num()];
+
+    PGL_OMP(for schedule(dynamic, 1))
+    for(int b = 0; b < nb_blocks; ++b)
+    {
+      // Vertices (or ranks) of the block.
+      for(v1 = b * triangle_block_size; v1 < std::min(nb_vertices, (b + 1) * triangle_block_size); ++v1)
+      {
+        // Sorted neighbours of v1. With triangles_by_vertex_order, the neighbours of lower ID are
+        //   skipped (ensures that each triangle is counted once).
+        const int* neighbours_v1 = list_neighbors + list_offsets[v1];
+        const int* neighbours_v1_end = list_neighbors + list_offsets[v1 + 1];
+        if(engine == triangles_by_vertex_order)
+        {
+          neighbours_v1 = std::upper_bound(neighbours_v1, neighbours_v1_end, v1);
+        }
+        d1 = neighbours_v1_end - neighbours_v1;
+        intersection.resize(d1);
+        // Loops over the neighbours of vertex v1.
+        for(int n1(0); n1<d1; ++n1)
+        {
+          v2 = neighbours_v1[n1];
+          // Sorted neighbours of v2 following v2 (ensures that each triangle is counted once).
+          const int* neighbours_v2 = list_neighbors + list_offsets[v2];
+          const int* neighbours_v2_end = list_neighbors + list_offsets[v2 + 1];
+          if(engine == triangles_by_vertex_order)
+          {
+            neighbours_v2 = std::upper_bound(neighbours_v2, neighbours_v2_end, v2);
+          }
+          d2 = neighbours_v2_end - neighbours_v2;
+          // Identifies the triangles (the common neighbours are found in increasing order).
+          d3 = intersect_sorted(neighbours_v1 + n1 + 1, d1 - n1 - 1, neighbours_v2, d2, &intersection[0]);
+          const int* position_v3_in_v1 = neighbours_v1 + n1 + 1;
+          const int* position_v3_in_v2 = neighbours_v2;
+          for(int n(0); n<d3; ++n)
+          {
+            // Directions of the edges v1-v2, v2-v3 and v3-v1.
+            position_v3_in_v1 = std::lower_bound(position_v3_in_v1, neighbours_v1_end, intersection[n]);
+            position_v3_in_v2 = std::lower_bound(position_v3_in_v2, neighbours_v2_end, intersection[n]);
+            directions[0] = list_directions[neighbours_v1 + n1 - list_neighbors];
+            directions[1] = list_directions[position_v3_in_v2 - list_neighbors];
+            directions[2] = reverse_directions(list_directions[position_v3_in_v1 - list_neighbors]);
+            triangle[0] = v1;
+            triangle[1] = v2;
+            triangle[2] = intersection[n];
+            if(engine == triangles_by_degree_order)
+            {
+              // Identifies the vertices and orders them by increasing ID (the directions are
+              //   rotated and/or reversed accordingly).
+              triangle[0] = Rank2Vertex[triangle[0]];
+              triangle[1] = Rank2Vertex[triangle[1]];
+              triangle[2] = Rank2Vertex[triangle[2]];
+              sort_triangle(triangle, directions);
+            }
+            visitor(b, triangle, directions[0] | (directions[1] << 2) | (directions[2] << 4));
+          }
+        }
+      }
+    }
   }
-  available_vertex_integer_prop.insert(prop);
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::add_new_vertex_property(std::string prop, std::string prop_header)
+template<typename EdgeOffset>
+template<typename Visitor>
+void pgl::basic_directed_graph_t<EdgeOffset>::visit_triangles(Visitor& visitor, triangle_engine_t engine)
 {
-  if(prop_header == "")
+  // Every thread other than the first one visits the triangles with its own visitor, which starts
+  //   empty such that whatever the visitor held beforehand is only counted once.
+  int nb_threads = max_nb_threads();
+  std::vector<Visitor> copies(nb_threads - 1, Visitor());
+  std::vector< triangle_visitor_adapter_t<Visitor> > adapters(nb_threads);
+  std::vector< triangle_visitor_adapter_t<Visitor>* > thread_visitors(nb_threads);
+  for(int t(0); t<nb_threads; ++t)
   {
-    prop_header = prop;
+    adapters[t].visitor = (t == 0) ? &visitor : &copies[t - 1];
+    thread_visitors[t] = &adapters[t];
   }
-  if(available_vertex_prop.find(prop) != available_vertex_prop.end())
+
+  // Visits the triangles.
+  std::vector<EdgeOffset> undirected_offsets;
+  enumerate_triangles(thread_visitors, engine, undirected_offsets);
+
+  // Merges the copies.
+  for(int t(0); t<nb_threads - 1; ++t)
   {
-    std::cerr << "ERROR: Vertex property " << prop << " already exists." << std::endl;
-    std::terminate();
+    visitor.merge(copies[t]);
   }
-  available_vertex_prop.insert(prop);
-  int nb_vertices = g_prop["nb_vertices"];
-  v_prop_header[prop] = prop_header;
-  v_prop[prop] = std::vector<double>(nb_vertices, 0);
 }
 
 
-
-
-
-
-
-
-
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 1. INTERNAL MANAGMENT: AVERAGE VALUES OF VERTEX PROPERTIES
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-
-
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::compute_average_vertex_prop(std::string prop)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::survey_triangles(bool build_triangle_list, bool compute_undirected_local_clustering, triangle_engine_t engine)
 {
-  // ===============================================================================================
-  // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
-  std::vector<double>& Vertex2Prop = v_prop[prop];
-  // ===============================================================================================
-
-  // Checks if the property has been extracted/computed already.
-  if(v_prop[prop].size() != nb_vertices)
+  // Selects the version compiled for the requested outputs.
+  if(build_triangle_list)
   {
-    std::cerr << "ERROR: The property " << prop << " has not been extracted/computed." << std::endl;
-    std::terminate();
+    if(compute_undirected_local_clustering) { survey_triangles<true,  true >(engine); }
+    else                                    { survey_triangles<true,  false>(engine); }
   }
-
-  // Computes the average degree of vertices.
-  double sum_of_values = 0;
-  for(int v(0); v<nb_vertices; ++v)
+  else
   {
-    sum_of_values += Vertex2Prop[v];
+    if(compute_undirected_local_clustering) { survey_triangles<false, true >(engine); }
+    else                                    { survey_triangles<false, false>(engine); }
   }
-
-  // ===============================================================================================
-  // Updates the properties of the graph.
-  std::string avg_v_prop = "avg_" + prop;
-  g_prop[avg_v_prop] = sum_of_values / nb_vertices;
-  // ===============================================================================================
 }
 
 
-
-
-
-
-
-
-
-
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 2. INPUT
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-
-
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::load_graph_from_edgelist_file(std::string edgelist_filename)
+template<typename EdgeOffset>
+template<bool BuildTriangleList, bool ComputeUndirectedLocalClustering>
+void pgl::basic_directed_graph_t<EdgeOffset>::survey_triangles(triangle_engine_t engine)
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  edgelist.clear();
+  int nb_vertices = g_prop.nb_vertices;
+  triangles.clear();
+
+  v_prop.create("undir_local_clust", column_double).resize(nb_vertices, 0);
+  double* Vertex2UndirLocalClust = v_prop["undir_local_clust"].data<double>();
   // ===============================================================================================
 
-  // Stream objects.
-  std::fstream edgelist_file;
-  std::stringstream one_line;
-  // String objects.
-  std::string full_line, name1_str, name2_str;
+  // Variables.
+  typedef triangle_survey_visitor_t<BuildTriangleList, ComputeUndirectedLocalClustering> visitor_t;
+  double nb_triangles = 0;
+  double total_nb_triads = 0;
+  int nb_blocks = (nb_vertices + triangle_block_size - 1) / triangle_block_size;
+  int nb_threads = max_nb_threads();
+  // Triangles found in each block of vertices, which are concatenated in the order of the blocks
+  //   such that the list does not depend on the scheduling of the threads.
+  std::vector< std::vector<triangle_t> > block_triangles(BuildTriangleList ? nb_blocks : 0);
+  // Number of triangles each vertex belongs to, updated atomically by the threads.
+  std::vector<int64_t> nb_triangles_per_vertex(ComputeUndirectedLocalClustering ? nb_vertices : 0, 0);
+  // Visitors of the threads.
+  std::vector<visitor_t> visitors(nb_threads);
+  std::vector<visitor_t*> thread_visitors(nb_threads);
+  for(int t(0); t<nb_threads; ++t)
+  {
+    visitors[t].block_triangles = &block_triangles;
+    visitors[t].nb_triangles_per_vertex = nb_triangles_per_vertex.empty() ? NULL : &nb_triangles_per_vertex[0];
+    thread_visitors[t] = &visitors[t];
+  }
 
-  // Opens the stream and terminates if the operation did not succeed.
-  edgelist_file.open(edgelist_filename.c_str(), std::fstream::in);
-  if( !edgelist_file.is_open() )
+  // Finds all the triangles.
+  std::vector<EdgeOffset> undirected_offsets;
+  enumerate_triangles(thread_visitors, engine, undirected_offsets);
+
+  if(BuildTriangleList)
   {
-    std::cerr << "ERROR: Could not open file: " << edgelist_filename << "." << std::endl;
-    std::terminate();
+    // Concatenates the triangles found in each block.
+    std::vector<std::size_t> block_offsets(nb_blocks + 1, 0);
+    for(int b(0); b<nb_blocks; ++b)
+    {
+      block_offsets[b + 1] = block_offsets[b] + block_triangles[b].size();
+    }
+    triangles.resize(block_offsets[nb_blocks]);
+    PGL_OMP(parallel for schedule(dynamic, 1) num_threads(nb_threads))
+    for(int b = 0; b < nb_blocks; ++b)
+    {
+      std::copy(block_triangles[b].begin(), block_triangles[b].end(), triangles.begin() + block_offsets[b]);
+      std::vector<triangle_t>().swap(block_triangles[b]);
+    }
   }
-  else
+
+  // Compiles the undirected local clustering coefficients (2 of 2). The counts are integers such
+  //   that they do not depend on the scheduling.
+  PGL_OMP(parallel for schedule(static) num_threads(nb_threads) reduction(+:total_nb_triads))
+  for(int v1 = 0; v1 < nb_vertices; ++v1)
   {
-    // Reads the file line by line.
-    while( !edgelist_file.eof() )
+    int64_t d1 = undirected_offsets[v1 + 1] - undirected_offsets[v1];
+    if(ComputeUndirectedLocalClustering)
     {
-      // Reads a line of the file.
-      std::getline(edgelist_file, full_line);
-      edgelist_file >> std::ws;
-      one_line.str(full_line);
-      one_line >> std::ws;
-      one_line >> name1_str >> std::ws;
-      // Skips a line of comment.
-      if(name1_str == "#")
+      Vertex2UndirLocalClust[v1] = nb_triangles_per_vertex[v1];
+      if(d1 > 1)
       {
-        one_line.clear();
-        continue;
+        Vertex2UndirLocalClust[v1] /= d1 * (d1 - 1) / 2;
       }
-      one_line >> name2_str >> std::ws;
-      one_line.clear();
+    }
+    total_nb_triads += d1 * (d1 - 1) / 2;
+  }
 
-      // Adds the edge.
-      add_edge(name1_str, name2_str, false);
+  // Compiles the triangle spectrum.
+  triangle_spect.clear();
+  for(int c(0); c<nb_triangle_configurations; ++c)
+  {
+    double nb_triangles_c = 0;
+    for(int t(0); t<nb_threads; ++t)
+    {
+      nb_triangles_c += visitors[t].triangle_spect[c];
     }
+    triangle_spect[triangle_configuration_name(c)] = nb_triangles_c;
+    nb_triangles += nb_triangles_c;
   }
-  // Closes the stream.
-  edgelist_file.close();
+
+
   // ===============================================================================================
   // Updates the properties of the graph.
-  // g_prop["nb_edges"] = edgelist.size();
-  compute_density();
+  g_prop.nb_triangles = nb_triangles;
+  g_prop.total_nb_triads = total_nb_triads;
+  g_prop.undir_global_clust = 3 * nb_triangles / total_nb_triads;
+  g_prop.validate(graph_stats_t::stat_nb_triangles);
+  g_prop.validate(graph_stats_t::stat_total_nb_triads);
+  g_prop.validate(graph_stats_t::stat_undir_global_clust);
   // ===============================================================================================
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::load_vertices_properties(std::string prop_filename, int usecol, std::string prop, std::string prop_header, bool ignore_unknown_vertices)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::compile_triangle_spectrum()
+{
+  // The spectrum is compiled while surveying the triangles, which is only done again if the graph
+  //   has been modified since (or if the triangles have never been surveyed).
+  if(triangle_spect.empty() || g_prop.is_estimate(graph_stats_t::stat_nb_triangles))
+  {
+    survey_triangles(false, true);
+  }
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+int64_t pgl::basic_directed_graph_t<EdgeOffset>::estimate_triangles(double relative_error, double confidence, uint64_t seed, int64_t max_nb_samples)
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  add_new_vertex_property(prop, prop_header);
-  std::vector<double>& Vertex2Prop = v_prop[prop];
-  // ===============================================================================================
-  // Stream object.
-  std::stringstream one_line;
-  // String objects.
-  std::string full_line, name_str, value_str;
-  // Variable.
-  int idx;
-  double tmp_value, dummy;
-  bool is_integer = true;
-  // Opens the stream and terminates if the operation did not succeed.
-  std::fstream prop_file(prop_filename.c_str(), std::fstream::in);
-  if( !prop_file.is_open() )
+  int nb_vertices = g_prop.nb_vertices;
+  triangles.clear();
+  // ===============================================================================================
+
+  if(relative_error <= 0 || confidence <= 0 || confidence >= 1)
   {
-    std::cerr << "Could not open file: " << prop_filename << "." << std::endl;
+    std::cerr << "ERROR: The relative error must be positive and the confidence level must be in (0, 1)." << std::endl;
     std::terminate();
   }
-  // Reads the property file line by line.
-  while( !prop_file.eof() )
+
+  // Builds the undirected adjacency list.
+  std::vector<EdgeOffset> offsets;
+  std::vector<int> neighbors;
+  std::vector<unsigned char> directions;
+  build_undirected_adjacency_list(offsets, neighbors, directions);
+
+  // Cumulative number of wedges centered on the vertices (the center of a wedge is drawn with a
+  //   probability proportional to its number of wedges) and vertices centering at least one wedge.
+  std::vector<int64_t> cumulative_nb_wedges(nb_vertices + 1, 0);
+  std::vector<int> wedge_centers;
+  for(int v(0); v<nb_vertices; ++v)
   {
-    // Reads a line of the file.
-    std::getline(prop_file, full_line);
-    prop_file >> std::ws;
-    one_line.str(full_line);
-    one_line >> std::ws;
-    one_line >> name_str >> std::ws;
-    // Skips lines of comment.
-    // if(name_str == "#")
-    if(name_str.compare(0, 1, "#") == 0)
-    {
-      one_line.clear();
-      continue;
-    }
-    // Identifies the vertex and may ignore unknown vertices.
-    idx = add_vertex(name_str, ignore_unknown_vertices);
-    if(idx == g_prop["nb_vertices"])
-    {
-      one_line.clear();
-      continue;
-    }
-    // Inputs the property.
-    for(int r(1); r<usecol; ++r)
+    int64_t d = offsets[v + 1] - offsets[v];
+    cumulative_nb_wedges[v + 1] = cumulative_nb_wedges[v] + d * (d - 1) / 2;
+    if(d > 1)
     {
-      one_line >> value_str >> std::ws;
+      wedge_centers.push_back(v);
     }
-    one_line >> value_str >> std::ws;
-    tmp_value = std::atof(value_str.c_str());
-    if(Vertex2Prop.size() == idx)
+  }
+  int64_t total_nb_triads = cumulative_nb_wedges[nb_vertices];
+  int nb_wedge_centers = wedge_centers.size();
+
+  // Samples wedges by blocks, each with its own random generator, such that the estimates do not
+  //   depend on the number of threads. Each sample draws a wedge uniformly among all wedges (global
+  //   clustering and spectrum) and a wedge centered on a vertex drawn uniformly (average local
+  //   clustering). Sampling stops once both counts of closed wedges reach the threshold of the
+  //   stopping rule of Dagum, Karp, Luby and Ross (SIAM J. Comput. 29, 2000), which guarantees the
+  //   relative error with probability (1 + confidence) / 2 for each coefficient.
+  double delta = (1 - confidence) / 2;
+  double stopping_threshold = 1 + 4 * (std::exp(1.0) - 2) * (1 + relative_error) * std::log(2 / delta) / (relative_error * relative_error);
+  uint64_t salt = splitmix64(seed);
+  int64_t nb_closed_wedges = 0, nb_closed_local_wedges = 0;
+  int64_t closed_spect[nb_triangle_configurations];
+  std::fill(closed_spect, closed_spect + nb_triangle_configurations, 0);
+  int nb_blocks = 0;
+  int64_t nb_samples = 0;
+  bool is_precise = (total_nb_triads == 0);
+  while(!is_precise && nb_samples < max_nb_samples)
+  {
+    // Number of blocks expected to reach the threshold (at most doubling the number of samples).
+    int nb_new_blocks = std::max(1, nb_blocks);
+    int64_t nb_closed = std::min(nb_closed_wedges, nb_closed_local_wedges);
+    if(nb_closed > 0)
     {
-      Vertex2Prop.push_back(tmp_value);
+      double nb_missing_samples = (stopping_threshold - nb_closed) * nb_samples / nb_closed;
+      nb_new_blocks = std::min<double>(nb_new_blocks, std::ceil(nb_missing_samples / wedge_sample_block_size));
     }
-    else
+    nb_new_blocks = std::max(std::max(1, nb_new_blocks), std::min(nb_blocks, max_nb_threads()));
+    nb_new_blocks = std::min<int64_t>(nb_new_blocks, (max_nb_samples - nb_samples + wedge_sample_block_size - 1) / wedge_sample_block_size);
+    std::vector<int64_t> block_counts(nb_new_blocks * (2 + nb_triangle_configurations), 0);
+    PGL_OMP(parallel for schedule(dynamic, 1))
+    for(int b = 0; b < nb_new_blocks; ++b)
     {
-      Vertex2Prop[idx] = tmp_value;
+      int64_t* counts = &block_counts[b * (2 + nb_triangle_configurations)];
+      const int* adjacency = &neighbors[0];
+      splitmix64_generator_t rng(salt + nb_blocks + b);
+      for(int s(0); s<wedge_sample_block_size; ++s)
+      {
+        for(int local(0); local<2; ++local)
+        {
+          // Draws the center and two of its neighbours.
+          int v;
+          if(local == 0)
+          {
+            int64_t w = rng() % static_cast<uint64_t>(total_nb_triads);
+            v = std::upper_bound(cumulative_nb_wedges.begin(), cumulative_nb_wedges.end(), w) - cumulative_nb_wedges.begin() - 1;
+          }
+          else
+          {
+            v = wedge_centers[rng.uniform(nb_wedge_centers)];
+          }
+          int d = offsets[v + 1] - offsets[v];
+          int i1 = rng.uniform(d);
+          int i2 = rng.uniform(d - 1);
+          i2 += (i2 >= i1) ? 1 : 0;
+          int v1 = adjacency[offsets[v] + i1];
+          int v2 = adjacency[offsets[v] + i2];
+          // Checks whether the wedge is closed (looking in the shortest list of neighbours).
+          int directions12 = 0;
+          if(offsets[v1 + 1] - offsets[v1] <= offsets[v2 + 1] - offsets[v2])
+          {
+            const int* last = adjacency + offsets[v1 + 1];
+            const int* it = std::lower_bound(adjacency + offsets[v1], last, v2);
+            directions12 = (it != last && *it == v2) ? directions[it - adjacency] : 0;
+          }
+          else
+          {
+            const int* last = adjacency + offsets[v2 + 1];
+            const int* it = std::lower_bound(adjacency + offsets[v2], last, v1);
+            directions12 = (it != last && *it == v1) ? reverse_directions(directions[it - adjacency]) : 0;
+          }
+          if(directions12 != 0)
+          {
+            counts[local] += 1;
+            if(local == 0)
+            {
+              int mask = directions[offsets[v] + i1] | (directions12 << 2) | (reverse_directions(directions[offsets[v] + i2]) << 4);
+              counts[2 + triangle_configuration(mask)] += 1;
+            }
+          }
+        }
+      }
     }
-    if( is_integer && (std::modf(tmp_value, &dummy) != 0) )
+    // Gathers the counts in the order of the blocks.
+    for(int b(0); b<nb_new_blocks; ++b)
     {
-      is_integer = false;
+      const int64_t* counts = &block_counts[b * (2 + nb_triangle_configurations)];
+      nb_closed_wedges += counts[0];
+      nb_closed_local_wedges += counts[1];
+      for(int c(0); c<nb_triangle_configurations; ++c)
+      {
+        closed_spect[c] += counts[2 + c];
+      }
     }
-    // Resets the stringstream.
-    one_line.clear();
+    nb_blocks += nb_new_blocks;
+    nb_samples = static_cast<int64_t>(nb_blocks) * wedge_sample_block_size;
+    is_precise = std::min(nb_closed_wedges, nb_closed_local_wedges) >= stopping_threshold;
   }
-  // Closes the stream.
-  prop_file.close();
+
+  // Fraction of closed wedges (the estimates are exact if the graph contains no wedge).
+  double closed_fraction = (nb_samples > 0) ? nb_closed_wedges / static_cast<double>(nb_samples) : 0;
+  double closed_local_fraction = (nb_samples > 0) ? nb_closed_local_wedges / static_cast<double>(nb_samples) : 0;
+
+  // Compiles the triangle spectrum (each triangle closes 3 wedges).
+  triangle_spect.clear();
+  for(int c(0); c<nb_triangle_configurations; ++c)
+  {
+    double fraction = (nb_samples > 0) ? closed_spect[c] / static_cast<double>(nb_samples) : 0;
+    triangle_spect[triangle_configuration_name(c)] = static_cast<int64_t>(fraction * total_nb_triads / 3 + 0.5);
+  }
+
   // ===============================================================================================
-  // Initializes relevant objects of the class.
-  if(is_integer)
+  // Updates the properties of the graph (vertices centering no wedge have a local clustering
+  //   coefficient of 0).
+  g_prop.nb_triangles = static_cast<int64_t>(closed_fraction * total_nb_triads / 3 + 0.5);
+  g_prop.total_nb_triads = total_nb_triads;
+  g_prop.undir_global_clust = (total_nb_triads > 0) ? closed_fraction : 3 * static_cast<double>(g_prop.nb_triangles) / total_nb_triads;
+  g_prop.validate(graph_stats_t::stat_nb_triangles);
+  g_prop.validate(graph_stats_t::stat_total_nb_triads);
+  g_prop.validate(graph_stats_t::stat_undir_global_clust);
+  g_prop["avg_undir_local_clust"] = closed_local_fraction * nb_wedge_centers / nb_vertices;
+  if(nb_samples > 0)
   {
-    available_vertex_integer_prop.insert(prop);
+    // Relative interval guaranteed by the stopping rule or, if the maximal number of samples has
+    //   been reached first, Hoeffding interval.
+    double lower = closed_fraction * (1 - relative_error);
+    double upper = closed_fraction * (1 + relative_error);
+    if(!is_precise)
+    {
+      double half_width = std::sqrt(std::log(2 / delta) / (2.0 * nb_samples));
+      lower = std::max(0.0, closed_fraction - half_width);
+      upper = std::min(1.0, closed_fraction + half_width);
+    }
+    g_prop.set_estimate(graph_stats_t::stat_undir_global_clust, lower, upper);
+    g_prop.set_estimate(graph_stats_t::stat_nb_triangles, lower * total_nb_triads / 3, upper * total_nb_triads / 3);
   }
   // ===============================================================================================
-}
-
-
-
-
-
-
-
-
 
+  return nb_samples;
+}
 
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 3. OUTPUT
-// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::save_vertices_properties(std::string filename, std::vector<std::string> props_id, vID_t vID, int width, bool header)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::save_triangles(std::string filename, triangle_file_format_t format, vID_t vID, triangle_engine_t engine)
 {
-  // Stream objects.
-  std::fstream output_file;
-  // Opens the stream and terminates if the operation did not succeed.
-  output_file.open(filename.c_str(), std::fstream::out);
-  if( !output_file.is_open() )
-  {
-    std::cerr << "ERROR: Could not open file: " << filename << "." << std::endl;
-    std::terminate();
-  }
-
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
+  int nb_vertices = g_prop.nb_vertices;
   // ===============================================================================================
 
-  // Number of properties.
-  int nb_props = props_id.size();
-
-  // Checks whether all properties have been extracted/computed.
-  for(int i(0); i<nb_props; ++i)
-  {
-    is_vertex_property(props_id[i]);
-    if(v_prop[props_id[i]].size() != nb_vertices)
-    {
-      std::cerr << "ERROR: The property " << props_id[i] << " has not been extracted/computed." << std::endl;
-      std::terminate();
-    }
-  }
-
   // Ensures that the ID2Name has been built. Otherwise, build it.
-  if(ID2Name.size() != nb_vertices)
+  bool use_names = (format == triangles_text && vID == vID_name);
+  if(use_names && ID2Name.size() != nb_vertices)
   {
     build_ID2Name();
   }
 
-  // Prints the header (if required).
-  if(header)
+  // Opens the file and terminates if the operation did not succeed.
+  triangle_writer_t writer;
+  if( !writer.open(filename, format == triangles_binary, use_names ? &ID2Name : NULL) )
   {
-    int i = 0;
-    if(vID == vID_name || vID == vID_num)
-    {
-      output_file << "#" << std::setw(width - 1) << "Vertex" << " ";
-      output_file << std::setw(width) << v_prop_header[props_id[i]] << " ";
-      ++i;
-    }
-    else if(vID == vID_none)
-    {
-      output_file << "#" << std::setw(width - 1) << v_prop_header[props_id[i]] << " ";
-      ++i;
-    }
-    else
-    {
-      std::cerr << "ERROR: Unknown vertex identifier type." << std::endl;
-      std::terminate();
-    }
-    for(; i<nb_props; ++i)
-    {
-      output_file << std::setw(width) << v_prop_header[props_id[i]] << " ";
-    }
-    output_file << std::endl;
+    std::cerr << "ERROR: Could not open file: " << filename << "." << std::endl;
+    std::terminate();
   }
 
-  // Prints the properties.
-  std::set< std::pair<std::string, int>, compare_names_directed_graph_t > ordered_names;
-  for(int v(0); v<nb_vertices; ++v)
+  // Finds the triangles with a single thread, such that they are written in a deterministic order.
+  triangle_export_visitor_t visitor(&writer);
+  std::vector<triangle_export_visitor_t*> thread_visitors(1, &visitor);
+  std::vector<EdgeOffset> undirected_offsets;
+  enumerate_triangles(thread_visitors, engine, undirected_offsets);
+
+  // Writes the remaining triangles and closes the file.
+  if( !writer.close() )
   {
-    ordered_names.insert(std::make_pair(ID2Name[v], v));
+    std::cerr << "ERROR: Could not write file: " << filename << "." << std::endl;
+    std::terminate();
   }
-  std::set< std::pair<std::string, int> >::iterator it  = ordered_names.begin();
-  std::set< std::pair<std::string, int> >::iterator end = ordered_names.end();
-  for(int v; it!=end; ++it)
+
+  // Compiles the triangle spectrum.
+  double nb_triangles = 0;
+  triangle_spect.clear();
+  for(int c(0); c<nb_triangle_configurations; ++c)
   {
-    v = it->second;
-    if(vID == vID_name)
-    {
-      output_file << std::setw(width) << ID2Name[v] << " ";
-    }
-    else if(vID == vID_num)
-    {
-      output_file << std::setw(width) << v << " ";
-    }
-    else if(vID == vID_none) { }
-    else
-    {
-      std::cerr << "ERROR: Unknown vertex identifier type." << std::endl;
-      std::terminate();
-    }
-    for(int i(0); i<nb_props; ++i)
-    {
-      if(is_vertex_integer_property(props_id[i], false))
-      {
-        output_file << std::setw(width) << std::setprecision(0) << std::fixed << v_prop[props_id[i]][v] << " ";
-      }
-      else
-      {
-        output_file << std::setw(width) << std::setprecision(6) << std::scientific << v_prop[props_id[i]][v] << " ";
-      }
-    }
-    output_file << std::endl;
+    triangle_spect[triangle_configuration_name(c)] = visitor.triangle_spect[c];
+    nb_triangles += visitor.triangle_spect[c];
   }
 
-  // Closes the stream.
-  output_file.close();
+  // ===============================================================================================
+  // Updates the properties of the graph.
+  g_prop.nb_triangles = nb_triangles;
+  g_prop.validate(graph_stats_t::stat_nb_triangles);
+  // ===============================================================================================
 }
 
 
@@ -845,152 +5560,327 @@ void pgl::directed_graph_t::save_vertices_properties(std::string filename, std::
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 4. DEGREE
+// 6. INCREMENTAL UPDATES
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 
+
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::compute_degrees()
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::enable_live_metrics()
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
-  v_prop["in-degree"].clear();
-  v_prop["out-degree"].clear();
-  std::vector<double>& Vertex2InDegree = v_prop["in-degree"];
-  std::vector<double>& Vertex2OutDegree = v_prop["out-degree"];
-  Vertex2InDegree.resize(nb_vertices, 0);
-  Vertex2OutDegree.resize(nb_vertices, 0);
+  int nb_vertices = g_prop.nb_vertices;
+  live_metrics = live_metrics_t();
   // ===============================================================================================
 
-  // Extracts the degrees from the adjacency list (if already generated).
-  if(adjacency_list.size() == nb_vertices)
+  // Computes the degrees and the reciprocity (also builds the adjacency list).
+  compute_degrees();
+  compute_reciprocity();
+
+  // Copies the adjacency list into lists of neighbours that can be modified.
+  std::vector<int> buffer;
+  for(int idx(0); idx<2; ++idx)
   {
-    // Loops over all vertices.
+    live_metrics.neighbors[idx].resize(nb_vertices);
     for(int v(0); v<nb_vertices; ++v)
     {
-      Vertex2InDegree[v] = adjacency_list[v][InDegreeIdx].size();
-      Vertex2OutDegree[v] = adjacency_list[v][OutDegreeIdx].size();
+      neighbor_range_t range = neighbors(v, idx, buffer);
+      live_metrics.neighbors[idx][v].assign(range.begin(), range.end());
     }
   }
-  // Otherwise extracts the degrees from the edgelist.
-  else
+
+  // Counts the triangles of every vertex and of every configuration.
+  triangle_count_visitor_t counter;
+  visit_triangles(counter);
+  live_metrics.nb_triangles_per_vertex.swap(counter.nb_triangles_per_vertex);
+  live_metrics.nb_triangles_per_vertex.resize(nb_vertices, 0);
+  std::copy(counter.triangle_spect, counter.triangle_spect + nb_triangle_configurations, live_metrics.triangle_spect);
+  g_prop.nb_triangles = 0;
+  for(int c(0); c<nb_triangle_configurations; ++c)
   {
-    // Loops over all edges.
-    int v1, v2;
-    std::set< std::pair<int, int> >::iterator it = edgelist.begin();
-    std::set< std::pair<int, int> >::iterator end = edgelist.end();
-    for(; it!=end; ++it)
-    {
-      // Identifies the vertices.
-      v1 = it->first;
-      v2 = it->second;
-      // Adds the contribution to the degree of vertices.
-      Vertex2OutDegree[v1] += 1;
-      Vertex2InDegree[v2] += 1;
-    }
+    g_prop.nb_triangles += live_metrics.triangle_spect[c];
   }
 
-  // Counts the number of vertices with total degree of 0 or 1.
-  int nb_vertices_deg_0 = 0;
-  int nb_vertices_deg_1 = 0;
+  // Counts the number of triads.
+  live_metrics.undirected_degree.resize(nb_vertices);
+  g_prop.total_nb_triads = 0;
   for(int v(0); v<nb_vertices; ++v)
   {
-    if(Vertex2OutDegree[v] == 0 && Vertex2InDegree[v] == 0)
-    {
-      nb_vertices_deg_0 += 1;
-    }
-    else if(Vertex2OutDegree[v] == 1 && Vertex2InDegree[v] == 0)
-    {
-      nb_vertices_deg_1 += 1;
-    }
-    else if(Vertex2OutDegree[v] == 0 && Vertex2InDegree[v] == 1)
-    {
-      nb_vertices_deg_1 += 1;
-    }
+    const std::vector<int>& in = live_metrics.neighbors[InDegreeIdx][v];
+    const std::vector<int>& out = live_metrics.neighbors[OutDegreeIdx][v];
+    int64_t d = union_size(in.empty() ? NULL : &in[0], in.size(), out.empty() ? NULL : &out[0], out.size());
+    live_metrics.undirected_degree[v] = d;
+    g_prop.total_nb_triads += d * (d - 1) / 2;
   }
 
-  // ===============================================================================================
-  // Updates the properties of the graph.
-  g_prop["nb_vertices_undir_deg_0"] = nb_vertices_deg_0;
-  g_prop["nb_vertices_undir_deg_1"] = nb_vertices_deg_1;
-  // ===============================================================================================
+  // Resolves the vertex properties that are kept up to date.
+  v_prop.create("undir_local_clust", column_double).resize(nb_vertices, 0);
+  live_metrics.in_degree = v_prop.handle("in-degree");
+  live_metrics.out_degree = v_prop.handle("out-degree");
+  live_metrics.reciprocal_degree = v_prop.handle("reciprocal_degree");
+  live_metrics.reciprocity_jaccard = v_prop.handle("reciprocity_jaccard");
+  live_metrics.reciprocity_ratio = v_prop.handle("reciprocity_ratio");
+  live_metrics.undir_local_clust = v_prop.handle("undir_local_clust");
+
+  // Computes the metrics of every vertex and of the graph.
+  live_metrics.enabled = true;
+  for(int v(0); v<nb_vertices; ++v)
+  {
+    update_live_vertex(v);
+  }
+  update_live_statistics();
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::disable_live_metrics()
+{
+  live_metrics = live_metrics_t();
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+bool pgl::basic_directed_graph_t<EdgeOffset>::has_live_edge(int v_source, int v_target) const
+{
+  const std::vector<int>& out = live_metrics.neighbors[OutDegreeIdx][v_source];
+  return std::binary_search(out.begin(), out.end(), v_target);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+int pgl::basic_directed_graph_t<EdgeOffset>::live_directions(int v1, int v2) const
+{
+  return (has_live_edge(v1, v2) ? edge_to_neighbour : 0) | (has_live_edge(v2, v1) ? edge_from_neighbour : 0);
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::live_undirected_neighbors(int v, std::vector<int>& neighbors) const
+{
+  const std::vector<int>& in = live_metrics.neighbors[InDegreeIdx][v];
+  const std::vector<int>& out = live_metrics.neighbors[OutDegreeIdx][v];
+  neighbors.resize(in.size() + out.size());
+  neighbors.erase(std::set_union(in.begin(), in.end(), out.begin(), out.end(), neighbors.begin()), neighbors.end());
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::compute_density()
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::count_live_degree_class(int v, int sign)
 {
-  g_prop["density"] = g_prop["nb_edges"] / (g_prop["nb_vertices"] * (g_prop["nb_vertices"] - 1));
+  int degree = live_metrics.neighbors[InDegreeIdx][v].size() + live_metrics.neighbors[OutDegreeIdx][v].size();
+  if(degree == 0)
+  {
+    g_prop.nb_vertices_undir_deg_0 += sign;
+  }
+  else if(degree == 1)
+  {
+    g_prop.nb_vertices_undir_deg_1 += sign;
+  }
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::compute_reciprocity()
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::add_live_vertices()
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
-  int nb_edges = g_prop["nb_edges"];
+  int nb_vertices = g_prop.nb_vertices;
+  int first_new_vertex = live_metrics.undirected_degree.size();
+  // ===============================================================================================
+
+  // Extends the counts and the vertex properties (new vertices have no edges).
+  for(int idx(0); idx<2; ++idx)
+  {
+    live_metrics.neighbors[idx].resize(nb_vertices);
+  }
+  live_metrics.undirected_degree.resize(nb_vertices, 0);
+  live_metrics.nb_triangles_per_vertex.resize(nb_vertices, 0);
+  int handles[] = { live_metrics.in_degree, live_metrics.out_degree, live_metrics.reciprocal_degree,
+                    live_metrics.reciprocity_jaccard, live_metrics.reciprocity_ratio, live_metrics.undir_local_clust };
+  for(int h(0); h<6; ++h)
+  {
+    v_prop[handles[h]].resize(nb_vertices, 0);
+  }
+  for(int v(first_new_vertex); v<nb_vertices; ++v)
+  {
+    count_live_degree_class(v, 1);
+    update_live_vertex(v);
+  }
+  update_live_statistics();
+}
 
-  std::vector<double>& Vertex2InDegree = v_prop["in-degree"];
-  std::vector<double>& Vertex2OutDegree = v_prop["out-degree"];
 
-  v_prop["reciprocal_degree"].clear();
-  std::vector<double>& Vertex2ReciprocalDegree = v_prop["reciprocal_degree"];
-  Vertex2ReciprocalDegree.resize(nb_vertices, 0);
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::update_live_vertex(int v)
+{
+  // Local reciprocity (same expressions as in compute_reciprocity).
+  int reciprocal_degree = v_prop[live_metrics.reciprocal_degree].template data<int32_t>()[v];
+  double total_degree = live_metrics.neighbors[InDegreeIdx][v].size() + live_metrics.neighbors[OutDegreeIdx][v].size();
+  v_prop[live_metrics.reciprocity_jaccard].template data<double>()[v] = reciprocal_degree / (total_degree - reciprocal_degree);
+  v_prop[live_metrics.reciprocity_ratio].template data<double>()[v] = 2 * reciprocal_degree / total_degree;
+
+  // Undirected local clustering coefficient (same expression as in survey_triangles).
+  int64_t d = live_metrics.undirected_degree[v];
+  double nb_triangles = live_metrics.nb_triangles_per_vertex[v];
+  v_prop[live_metrics.undir_local_clust].template data<double>()[v] = (d > 1) ? nb_triangles / (d * (d - 1) / 2) : nb_triangles;
+}
 
-  v_prop["reciprocity_jaccard"].clear();
-  std::vector<double>& Vertex2ReciprocityJaccard = v_prop["reciprocity_jaccard"];
-  Vertex2ReciprocityJaccard.resize(nb_vertices, 0);
 
-  v_prop["reciprocity_ratio"].clear();
-  std::vector<double>& Vertex2ReciprocityRatio = v_prop["reciprocity_ratio"];
-  Vertex2ReciprocityRatio.resize(nb_vertices, 0);
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::update_live_edge(int v1, int v2, bool added)
+{
+  // ===============================================================================================
+  // Initializes relevant objects of the class.
+  std::vector<int>& out1 = live_metrics.neighbors[OutDegreeIdx][v1];
+  std::vector<int>& in2 = live_metrics.neighbors[InDegreeIdx][v2];
+  int sign = added ? 1 : -1;
   // ===============================================================================================
 
-  // Ensures that the in-/out-degrees have been computed.
-  if(Vertex2InDegree.size() != nb_vertices)
+  // The vertices are connected in the undirected graph before and after the change if the edge
+  //   v2 -> v1 exists.
+  bool reciprocal = has_live_edge(v2, v1);
+
+  // Removes the contributions of the two vertices to the number of vertices of degree 0 and 1.
+  count_live_degree_class(v1, -1);
+  count_live_degree_class(v2, -1);
+
+  // Common neighbours of the two vertices in the undirected graph (i.e., the third vertex of the
+  //   triangles containing the edge).
+  std::vector<int> neighbors1, neighbors2;
+  live_undirected_neighbors(v1, neighbors1);
+  live_undirected_neighbors(v2, neighbors2);
+  std::vector<int> common(std::min(neighbors1.size(), neighbors2.size()));
+  if(!common.empty())
   {
-    compute_degrees();
+    common.resize(intersect_sorted(&neighbors1[0], neighbors1.size(), &neighbors2[0], neighbors2.size(), &common[0]));
   }
+  int nb_common = common.size();
 
-  // Runs over the edgelist and counts (twice!) the number of reciprocal edges.
-  double nb_reciprocal_edges = 0;
-  edgelist_iterator it = edgelist_begin();
-  edgelist_iterator end = edgelist_end();
-  for(; it!=end; ++it)
+  // Removes the configurations of the triangles existing before the change.
+  if(reciprocal || !added)
   {
-    if(it->first < it->second)
+    for(int i(0); i<nb_common; ++i)
     {
-      if(is_edge(it->second, it->first))
-      {
-        nb_reciprocal_edges += 2;
-        Vertex2ReciprocalDegree[it->first] += 1;
-        Vertex2ReciprocalDegree[it->second] += 1;
-        Vertex2ReciprocityJaccard[it->first] += 1;
-        Vertex2ReciprocityJaccard[it->second] += 1;
-        Vertex2ReciprocityRatio[it->first] += 2;
-        Vertex2ReciprocityRatio[it->second] += 2;
-      }
+      int w = common[i];
+      live_metrics.triangle_spect[triangle_configuration(live_directions(v1, v2) | (live_directions(v2, w) << 2) | (live_directions(w, v1) << 4))] -= 1;
     }
   }
 
-  // Completes the calculation of the overlap between in- and out-neighborhoods.
-  for(int v(0); v<nb_vertices; ++v)
+  // Updates the lists of neighbours and the degrees.
+  if(added)
+  {
+    out1.insert(std::lower_bound(out1.begin(), out1.end(), v2), v2);
+    in2.insert(std::lower_bound(in2.begin(), in2.end(), v1), v1);
+  }
+  else
+  {
+    out1.erase(std::lower_bound(out1.begin(), out1.end(), v2));
+    in2.erase(std::lower_bound(in2.begin(), in2.end(), v1));
+  }
+  v_prop[live_metrics.out_degree].template data<int32_t>()[v1] += sign;
+  v_prop[live_metrics.in_degree].template data<int32_t>()[v2] += sign;
+
+  // Adds the configurations of the triangles existing after the change.
+  if(reciprocal || added)
+  {
+    for(int i(0); i<nb_common; ++i)
+    {
+      int w = common[i];
+      live_metrics.triangle_spect[triangle_configuration(live_directions(v1, v2) | (live_directions(v2, w) << 2) | (live_directions(w, v1) << 4))] += 1;
+    }
+  }
+
+  if(reciprocal)
+  {
+    // The edge forms (or formed) a reciprocal pair with v2 -> v1.
+    g_prop.nb_reciprocal_edges += 2 * sign;
+    v_prop[live_metrics.reciprocal_degree].template data<int32_t>()[v1] += sign;
+    v_prop[live_metrics.reciprocal_degree].template data<int32_t>()[v2] += sign;
+  }
+  else
   {
-    Vertex2ReciprocityJaccard[v] /= Vertex2InDegree[v] + Vertex2OutDegree[v] - Vertex2ReciprocityJaccard[v];
-    Vertex2ReciprocityRatio[v] /= Vertex2InDegree[v] + Vertex2OutDegree[v];
+    // The vertices become (or cease to be) connected in the undirected graph. The number of triads
+    //   centered on a vertex of degree d, d(d-1)/2, increases by d when its degree increases by 1.
+    if(added)
+    {
+      g_prop.total_nb_triads += live_metrics.undirected_degree[v1] + live_metrics.undirected_degree[v2];
+      live_metrics.undirected_degree[v1] += 1;
+      live_metrics.undirected_degree[v2] += 1;
+    }
+    else
+    {
+      live_metrics.undirected_degree[v1] -= 1;
+      live_metrics.undirected_degree[v2] -= 1;
+      g_prop.total_nb_triads -= live_metrics.undirected_degree[v1] + live_metrics.undirected_degree[v2];
+    }
+    // Triangles formed (or broken) with the common neighbours.
+    g_prop.nb_triangles += sign * nb_common;
+    live_metrics.nb_triangles_per_vertex[v1] += sign * nb_common;
+    live_metrics.nb_triangles_per_vertex[v2] += sign * nb_common;
+    for(int i(0); i<nb_common; ++i)
+    {
+      live_metrics.nb_triangles_per_vertex[common[i]] += sign;
+      update_live_vertex(common[i]);
+    }
   }
 
+  // Adds the new contributions of the two vertices and updates their metrics.
+  count_live_degree_class(v1, 1);
+  count_live_degree_class(v2, 1);
+  update_live_vertex(v1);
+  update_live_vertex(v2);
+
   // ===============================================================================================
   // Updates the properties of the graph.
+  update_live_statistics();
+  // ===============================================================================================
+}
+
+
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+// =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::update_live_statistics()
+{
+  // The list of triangles is not maintained.
+  triangles.clear();
+
+  // Triangle spectrum.
+  triangle_spect.clear();
+  for(int c(0); c<nb_triangle_configurations; ++c)
+  {
+    triangle_spect[triangle_configuration_name(c)] = live_metrics.triangle_spect[c];
+  }
+
+  // ===============================================================================================
+  // Updates the properties of the graph (same expressions as in compute_reciprocity and
+  //   survey_triangles).
   compute_density();
-  g_prop["nb_reciprocal_edges"] = nb_reciprocal_edges;
-  g_prop["reciprocity_ratio"] = nb_reciprocal_edges / g_prop["nb_edges"];
-  g_prop["reciprocity_stat"] = (g_prop["reciprocity_ratio"] - g_prop["density"]) / (1 - g_prop["density"]);
+  g_prop.reciprocity_ratio = static_cast<double>(g_prop.nb_reciprocal_edges) / g_prop.nb_edges;
+  g_prop.reciprocity_stat = (g_prop.reciprocity_ratio - g_prop.density) / (1 - g_prop.density);
+  g_prop.undir_global_clust = 3 * static_cast<double>(g_prop.nb_triangles) / g_prop.total_nb_triads;
+  for(int stat(0); stat<graph_stats_t::nb_stats; ++stat)
+  {
+    g_prop.validate(static_cast<graph_stats_t::stat_t>(stat));
+  }
   // ===============================================================================================
 }
 
@@ -1004,255 +5894,267 @@ void pgl::directed_graph_t::compute_reciprocity()
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// 5. TRIANGLES
+// 7. ORDERING OF THE VERTICES
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 
+
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::survey_triangles(bool build_triangle_list, bool compute_undirected_local_clustering)
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::reorder_vertices(vertex_order_t order)
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  int nb_vertices = g_prop["nb_vertices"];
-  triangles.clear();
-
-  v_prop["undir_local_clust"].clear();
-  std::vector<double>& Vertex2UndirLocalClust = v_prop["undir_local_clust"];
-  Vertex2UndirLocalClust.resize(nb_vertices, 0);
+  int nb_vertices = g_prop.nb_vertices;
+  bool is_live = live_metrics.enabled;
+  bool is_compressed = is_adjacency_list_compressed();
+  bool is_released = is_edgelist_released;
+  bool is_built = adjacency_list.size() == nb_vertices;
+  disable_live_metrics();
   // ===============================================================================================
 
-  // Variables.
-  int v2, v3, d1, d2;
-  double total_nb_triads = 0;
-  // Vector objects.
-  std::vector<int> intersection;
-  // Set objects.
-  std::set<int> neighbours_v1, neighbours_v2;
-  // Iterator objects.
-  std::vector<int>::iterator it;
-  std::set<int>::iterator it1, end1, it2, end2;
-  // Newly found triangle.
-  std::vector<int> triangle(3);
-
-  // Ensures that the adjacency list has been built.
-  if(adjacency_list.size() != nb_vertices)
+  // Computes the new order.
+  std::vector<int> Rank2Vertex;
+  order_vertices(order, Rank2Vertex);
+  std::vector<int> Vertex2Rank(nb_vertices);
+  for(int r(0); r<nb_vertices; ++r)
   {
-    build_adjacency_list();
+    Vertex2Rank[Rank2Vertex[r]] = r;
   }
 
-  // Finds all the triangles.
-  for(int v1(0); v1<nb_vertices; ++v1)
+  // Interns the names again in the new order.
+  name_table_t names;
+  names.arena.owned().reserve(Name2ID.arena.size());
+  names.offsets.owned().reserve(nb_vertices + 1);
+  for(int r(0); r<nb_vertices; ++r)
   {
-    // Total degree of vertex v1.
-    d1 = adjacency_list[v1][InDegreeIdx].size() + adjacency_list[v1][OutDegreeIdx].size();
-    // Performs the calculation only if d1>1.
-    if(d1 > 1)
-    {
-      // Builds an ordered list of the neighbourhood of v1
-      neighbours_v1.clear();
-      neighbours_v1.insert(adjacency_list[v1][InDegreeIdx].begin(), adjacency_list[v1][InDegreeIdx].end());
-      neighbours_v1.insert(adjacency_list[v1][OutDegreeIdx].begin(), adjacency_list[v1][OutDegreeIdx].end());
-      // Loops over the neighbours of vertex v1.
-      it1 = neighbours_v1.begin();
-      end1 = neighbours_v1.end();
-      for(; it1!=end1; ++it1)
-      {
-        // Identity and degree of vertex 2.
-        v2 = *it1;
-        if(v1 < v2)
-        {
-          // Total degree of vertex v2.
-          d2 = adjacency_list[v2][InDegreeIdx].size() + adjacency_list[v2][OutDegreeIdx].size();
-          // Performs the calculation only if d2>1 and if v2>v1 (ensures that each triangle is counted once).
-          if(d2 > 1)
-          {
-            // Builds an ordered list of the neighbourhood of v2
-            neighbours_v2.clear();
-            d2 = adjacency_list[v2][InDegreeIdx].size();
-            for(int n2(0); n2<d2; ++n2)
-            {
-              // Identifies the neighbors.
-              v3 = adjacency_list[v2][InDegreeIdx][n2];
-              if(v2 < v3) // Ensures that triangles will be counted only once.
-              {
-                neighbours_v2.insert(v3);
-              }
-            }
-            d2 = adjacency_list[v2][OutDegreeIdx].size();
-            for(int n2(0); n2<d2; ++n2)
-            {
-              // Identifies the neighbors.
-              v3 = adjacency_list[v2][OutDegreeIdx][n2];
-              if(v2 < v3) // Ensures that triangles will be counted only once.
-              {
-                neighbours_v2.insert(v3);
-              }
-            }
-            // Identifies the triangles.
-            d2 = neighbours_v2.size();
-            intersection.clear();
-            intersection.resize(std::min(d1, d2));
-            it = std::set_intersection(neighbours_v1.begin(), neighbours_v1.end(), neighbours_v2.begin(), neighbours_v2.end(), intersection.begin());
-            intersection.resize(it-intersection.begin());
-            // Loops over the common neighbours of vertices v1 and v2.
-            for(int n(0), nn(intersection.size()); n<nn; ++n)
-            {
-              triangle[0] = v1;
-              triangle[1] = v2;
-              triangle[2] = intersection[n];
-              if(build_triangle_list)
-              {
-                // Adds the triangle to the list.
-                triangles.push_back(triangle);
-              }
-              if(compute_undirected_local_clustering)
-              {
-                // Compiles the undirected local clustering coefficients (1 of 2).
-                Vertex2UndirLocalClust[ triangle[0] ] += 1;
-                Vertex2UndirLocalClust[ triangle[1] ] += 1;
-                Vertex2UndirLocalClust[ triangle[2] ] += 1;
-              }
-            }
-          }
-        }
-      }
-    }
+    name_ref_t name = Name2ID.name(Rank2Vertex[r]);
+    names.insert(name.data, name.length);
+  }
+  Name2ID = names;
+  build_ID2Name();
+  vertices_by_name.clear();
+
+  // Vertex properties.
+  v_prop.permute(Rank2Vertex);
+
+  // Renumbers the edges, which are then sorted again.
+  restore_edgelist();
+  edgelist.flush();
+  std::vector<edgelist_t::edge_t>& edges = edgelist.edges.owned();
+  EdgeOffset nb_edges = edges.size();
+  PGL_OMP(parallel for schedule(static))
+  for(EdgeOffset e = 0; e < nb_edges; ++e)
+  {
+    edges[e] = std::make_pair(Vertex2Rank[edges[e].first], Vertex2Rank[edges[e].second]);
   }
+  parallel_sort(edges);
 
-  if(compute_undirected_local_clustering)
+  // Renumbers the triangles (the vertices of each triangle are kept in increasing order).
+  for(std::size_t t(0), tt(triangles.size()); t<tt; ++t)
   {
-    // Compiles the undirected local clustering coefficients (2 of 2).
-    for(int v1(0); v1<nb_vertices; ++v1)
+    for(int i(0); i<3; ++i)
     {
-      intersection.clear();
-      d1 = adjacency_list[v1][InDegreeIdx].size() + adjacency_list[v1][OutDegreeIdx].size();
-      intersection.resize(d1);
-      it = std::set_union(adjacency_list[v1][InDegreeIdx].begin(), adjacency_list[v1][InDegreeIdx].end(), adjacency_list[v1][OutDegreeIdx].begin(), adjacency_list[v1][OutDegreeIdx].end(), intersection.begin());
-      intersection.resize(it-intersection.begin());
-      d1 = intersection.size();
-      if(d1 > 1)
-      {
-        Vertex2UndirLocalClust[v1] /= d1 * (d1 - 1) / 2;
-      }
-      total_nb_triads += d1 * (d1 - 1) / 2;
+      triangles[t][i] = Vertex2Rank[triangles[t][i]];
     }
+    std::sort(triangles[t].vertices, triangles[t].vertices + 3);
   }
 
+  // Rebuilds the adjacency list (in the same form) and the metrics kept up to date.
+  adjacency_list.clear();
+  compressed_adjacency_list.clear();
+  edge_index.clear();
+  if(is_compressed)
+  {
+    compress_adjacency_list(is_released);
+  }
+  else if(is_built)
+  {
+    build_adjacency_list();
+  }
+  if(is_live)
+  {
+    enable_live_metrics();
+  }
 
-  // ===============================================================================================
-  // Updates the properties of the graph.
-  g_prop["nb_triangles"] = triangles.size();
-  g_prop["total_nb_triads"] = total_nb_triads;
-  g_prop["undir_global_clust"] = 3 * g_prop["nb_triangles"] / g_prop["total_nb_triads"];
-  // ===============================================================================================
+  // The arrays of a binary snapshot, if any, have all been replaced.
+  snapshot_file.close();
 }
 
 
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-void pgl::directed_graph_t::compile_triangle_spectrum()
+template<typename EdgeOffset>
+void pgl::basic_directed_graph_t<EdgeOffset>::order_vertices(vertex_order_t order, std::vector<int>& Rank2Vertex)
 {
   // ===============================================================================================
   // Initializes relevant objects of the class.
-  // int nb_vertices = g_prop["nb_vertices"];
-  triangle_spect.clear();
-  triangle_spect["3cycle"] = 0;
-  triangle_spect["3nocycle"] = 0;
-  triangle_spect["4cycle"] = 0;
-  triangle_spect["4outward"] = 0;
-  triangle_spect["4inward"] = 0;
-  triangle_spect["5cycle"] = 0;
-  triangle_spect["6cycle"] = 0;
-  // ===============================================================================================
-
-  // Ensures that the triangles have been surveyed.
-  if(triangles.size() != 0)
-  {
-    survey_triangles();
-  }
-
-  // Builds a std::map to translate the 27 possible triangle configurations to
-  //   the 7 unique possible triangle configurations.
-  std::map<std::string, std::string> link2type;
-  link2type["111"] = "3cycle";
-  link2type["222"] = "3cycle";
-  link2type["211"] = "3nocycle";
-  link2type["121"] = "3nocycle";
-  link2type["112"] = "3nocycle";
-  link2type["122"] = "3nocycle";
-  link2type["212"] = "3nocycle";
-  link2type["221"] = "3nocycle";
-  link2type["311"] = "4cycle";
-  link2type["131"] = "4cycle";
-  link2type["113"] = "4cycle";
-  link2type["322"] = "4cycle";
-  link2type["232"] = "4cycle";
-  link2type["223"] = "4cycle";
-  link2type["123"] = "4outward";
-  link2type["312"] = "4outward";
-  link2type["231"] = "4outward";
-  link2type["321"] = "4inward";
-  link2type["132"] = "4inward";
-  link2type["213"] = "4inward";
-  link2type["133"] = "5cycle";
-  link2type["313"] = "5cycle";
-  link2type["331"] = "5cycle";
-  link2type["233"] = "5cycle";
-  link2type["323"] = "5cycle";
-  link2type["332"] = "5cycle";
-  link2type["333"] = "6cycle";
-
-  // Runs over the triangles and counts the frequency of each triangle
-  //   configurations.
-  std::string edge_config;
-  bool edge_01, edge_10, edge_12, edge_21, edge_20, edge_02;
-  for(int t(0), tt(g_prop["nb_triangles"]), v0, v1, v2; t<tt; ++t)
+  int nb_vertices = g_prop.nb_vertices;
+  Rank2Vertex.clear();
+  Rank2Vertex.reserve(nb_vertices);
+  // ===============================================================================================
+
+  // Undirected adjacency list.
+  std::vector<EdgeOffset> offsets;
+  std::vector<int> neighbors;
+  std::vector<unsigned char> directions;
+  build_undirected_adjacency_list(offsets, neighbors, directions);
+  std::vector<unsigned char>().swap(directions);
+
+  // Orders the vertices by decreasing undirected degree (ties are broken by ID).
+  std::vector< std::pair<int, int> > degree_and_vertex(nb_vertices);
+  for(int v(0); v<nb_vertices; ++v)
   {
-    // Identifies the vertices.
-    v0 = triangles[t][0];
-    v1 = triangles[t][1];
-    v2 = triangles[t][2];
-    // Identifies the configuration.
-    edge_config = "";
-    edge_01 = is_edge(v0, v1);
-    edge_10 = is_edge(v1, v0);
-    edge_12 = is_edge(v1, v2);
-    edge_21 = is_edge(v2, v1);
-    edge_20 = is_edge(v2, v0);
-    edge_02 = is_edge(v0, v2);
-    if(edge_01 && !edge_10)
-      edge_config += "1";
-    if(!edge_01 && edge_10)
-      edge_config += "2";
-    if(edge_01 && edge_10)
-      edge_config += "3";
-    if(edge_12 && !edge_21)
-      edge_config += "1";
-    if(!edge_12 && edge_21)
-      edge_config += "2";
-    if(edge_12 && edge_21)
-      edge_config += "3";
-    if(edge_20 && !edge_02)
-      edge_config += "1";
-    if(!edge_20 && edge_02)
-      edge_config += "2";
-    if(edge_20 && edge_02)
-      edge_config += "3";
-    triangle_spect[link2type[edge_config]] += 1;
+    degree_and_vertex[v] = std::make_pair(offsets[v] - offsets[v + 1], v);
+  }
+  parallel_sort(degree_and_vertex);
+  std::vector<int> by_degree(nb_vertices);
+  for(int r(0); r<nb_vertices; ++r)
+  {
+    by_degree[r] = degree_and_vertex[r].second;
+  }
+  std::vector< std::pair<int, int> >().swap(degree_and_vertex);
+  if(order == order_by_degree)
+  {
+    Rank2Vertex.swap(by_degree);
+    return;
   }
-}
-
 
+  std::vector<char> is_placed(nb_vertices, 0);
+  if(order == order_by_bfs || order == order_by_rcm)
+  {
+    // Traverses every component from its vertex of highest degree (BFS) or of lowest degree
+    //   (Cuthill-McKee, which visits the neighbours of each vertex by increasing degree).
+    std::vector< std::pair<int, int> > discovered;
+    for(int i(0); i<nb_vertices; ++i)
+    {
+      int root = (order == order_by_bfs) ? by_degree[i] : by_degree[nb_vertices - 1 - i];
+      if(is_placed[root])
+      {
+        continue;
+      }
+      is_placed[root] = 1;
+      Rank2Vertex.push_back(root);
+      for(std::size_t head(Rank2Vertex.size() - 1); head<Rank2Vertex.size(); ++head)
+      {
+        int v = Rank2Vertex[head];
+        discovered.clear();
+        for(EdgeOffset k(offsets[v]); k<offsets[v + 1]; ++k)
+        {
+          int u = neighbors[k];
+          if(!is_placed[u])
+          {
+            is_placed[u] = 1;
+            discovered.push_back(std::make_pair((order == order_by_rcm) ? offsets[u + 1] - offsets[u] : 0, u));
+          }
+        }
+        std::sort(discovered.begin(), discovered.end());
+        for(std::size_t j(0), jj(discovered.size()); j<jj; ++j)
+        {
+          Rank2Vertex.push_back(discovered[j].second);
+        }
+      }
+    }
+    if(order == order_by_rcm)
+    {
+      std::reverse(Rank2Vertex.begin(), Rank2Vertex.end());
+    }
+    return;
+  }
 
+  // Gorder-like ordering. The score of a vertex counts its edges and its common neighbours with
+  //   the last gorder_window_size vertices placed, and the vertex of highest score is placed next
+  //   (the vertex of highest degree left is placed if no vertex has a positive score). As in
+  //   Gorder, the neighbours of degree above sqrt(|V|) are not counted as common neighbours. The
+  //   scores are kept in a max-heap updated lazily: increases push a new entry, while entries
+  //   found to exceed the current score are pushed again with it (the heap is rebuilt when the
+  //   outdated entries outnumber the vertices).
+  int max_common_degree = static_cast<int>(std::sqrt(static_cast<double>(nb_vertices)));
+  std::vector<int> score(nb_vertices, 0);
+  std::vector< std::pair<int, int> > heap;
+  for(int r(0), next(0); r<nb_vertices; ++r)
+  {
+    // Selects the vertex of highest score (ties are broken by ID).
+    int v = -1;
+    while(!heap.empty() && v == -1)
+    {
+      std::pop_heap(heap.begin(), heap.end());
+      int u = -heap.back().second;
+      int entry_score = heap.back().first;
+      heap.pop_back();
+      if(!is_placed[u] && score[u] == entry_score)
+      {
+        v = u;
+      }
+      else if(!is_placed[u] && score[u] > 0 && score[u] < entry_score)
+      {
+        heap.push_back(std::make_pair(score[u], -u));
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+    while(v == -1)
+    {
+      if(!is_placed[by_degree[next]])
+      {
+        v = by_degree[next];
+      }
+      ++next;
+    }
+    is_placed[v] = 1;
+    Rank2Vertex.push_back(v);
 
+    // Updates the scores of the vertices entering and leaving the window.
+    int updated[2] = { v, (r >= gorder_window_size) ? Rank2Vertex[r - gorder_window_size] : -1 };
+    for(int i(0); i<2 && updated[i] != -1; ++i)
+    {
+      int w = updated[i];
+      int delta = (i == 0) ? 1 : -1;
+      for(EdgeOffset k(offsets[w]); k<offsets[w + 1]; ++k)
+      {
+        int u = neighbors[k];
+        if(!is_placed[u] && (score[u] += delta) > 0 && delta > 0)
+        {
+          heap.push_back(std::make_pair(score[u], -u));
+          std::push_heap(heap.begin(), heap.end());
+        }
+        if(offsets[u + 1] - offsets[u] > max_common_degree)
+        {
+          continue;
+        }
+        for(EdgeOffset kk(offsets[u]); kk<offsets[u + 1]; ++kk)
+        {
+          int x = neighbors[kk];
+          if(x != w && !is_placed[x] && (score[x] += delta) > 0 && delta > 0)
+          {
+            heap.push_back(std::make_pair(score[x], -x));
+            std::push_heap(heap.begin(), heap.end());
+          }
+        }
+      }
+    }
 
+    // Discards the outdated entries of the heap.
+    if(heap.size() > 2 * static_cast<std::size_t>(nb_vertices) + 1024)
+    {
+      heap.clear();
+      for(int u(0); u<nb_vertices; ++u)
+      {
+        if(!is_placed[u] && score[u] > 0)
+        {
+          heap.push_back(std::make_pair(score[u], -u));
+        }
+      }
+      std::make_heap(heap.begin(), heap.end());
+    }
+  }
+}
 
 
 
 
 
 // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// // 6. ACCESSORS FOR GRAPH PROPERTIES
+// // 8. ACCESSORS FOR GRAPH PROPERTIES
 // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 //
 // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
@@ -1299,7 +6201,7 @@ void pgl::directed_graph_t::compile_triangle_spectrum()
 
 
 // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
-// // 7. ACCESSORS FOR VERTEX PROPERTIES
+// // 8. ACCESSORS FOR VERTEX PROPERTIES
 // // =~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=~=
 //
 //
@@ -1309,7 +6211,7 @@ void pgl::directed_graph_t::compile_triangle_spectrum()
 // {
 //   // ===============================================================================================
 //   // Initializes relevant objects of the class.
-//   int nb_vertices = g_prop["nb_vertices"];
+//   int nb_vertices = g_prop.nb_vertices;
 //   std::vector<double>& Vertex2Prop = v_prop["reciprocity_ratio"];
 //   // ===============================================================================================
 //   // Ensures that the ID2Name has been built. Otherwise, build it.
@@ -0,0 +1,122 @@
+/*
+ *
+ *  This code compares the kernels intersecting sorted arrays of integers used by the
+ *    directed_graph_t class of the PGL (e.g., to survey triangles) for various ratios between the
+ *    sizes of the arrays. It also verifies that every kernel finds the same common elements.
+ *
+ *  Compilation: g++ -O3 benchmark_intersection_kernels.cpp
+ *
+ *  Author:  Antoine Allard
+ *  WWW:     antoineallard.info
+ *  Date:    August 2020
+ *
+ *
+ *  Copyright (C) 2020 Antoine Allard
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+ // Standard template library
+ #include <ctime>
+ #include <iomanip>
+ #include <iostream>
+ #include <string>
+ // Portable graph library
+ #include "../src/directed_graph_t.hpp"
+
+
+ // Draws a sorted array of distinct integers in [0, universe).
+ std::vector<int> random_sorted_array(int size, int universe)
+ {
+  std::set<int> elements;
+  while((int) elements.size() < size)
+  {
+    elements.insert(std::rand() % universe);
+  }
+  return std::vector<int>(elements.begin(), elements.end());
+ }
+
+
+ int main()
+ {
+  // Size of the smallest array.
+  int small_size = 1000;
+  // Total number of elements to go through for each measurement.
+  double nb_elements_per_measure = 2e8;
+
+  // Kernels supported by the processor.
+  std::vector<pgl::intersection_kernel_t> kernels = pgl::available_intersection_kernels();
+  std::cout << "Selected kernel: " << pgl::best_intersection_kernel().name << std::endl << std::endl;
+
+  // Header.
+  std::cout << std::setw(8) << "ratio" << " " << std::setw(10) << "kernel" << " ";
+  std::cout << std::setw(15) << "intersect (ns)" << " " << std::setw(15) << "count (ns)" << std::endl;
+
+  for(int ratio(1); ratio<=64; ratio*=2)
+  {
+    // Draws the arrays (about one element out of eight of the smallest array is common).
+    int large_size = small_size * ratio;
+    std::vector<int> a = random_sorted_array(small_size, 8 * large_size);
+    std::vector<int> b = random_sorted_array(large_size, 8 * large_size);
+    std::vector<int> out(small_size);
+    int nb_repetitions = std::max(1, (int) (nb_elements_per_measure / (small_size + large_size)));
+
+    // Reference intersection.
+    std::vector<int> reference(small_size);
+    reference.resize(std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), reference.begin()) - reference.begin());
+
+    // Adds the galloping search to the kernels.
+    std::vector<pgl::intersection_kernel_t> candidates = kernels;
+    pgl::intersection_kernel_t galloping = { "galloping", &pgl::intersect_sorted_galloping<true>, &pgl::intersect_sorted_galloping<false> };
+    candidates.push_back(galloping);
+
+    for(int k(0), kk(candidates.size()); k<kk; ++k)
+    {
+      // Verifies the kernels.
+      int nb_common = candidates[k].intersect(&a[0], small_size, &b[0], large_size, &out[0]);
+      if(nb_common != (int) reference.size() || !std::equal(reference.begin(), reference.end(), out.begin()) ||
+         candidates[k].count(&b[0], large_size, &a[0], small_size, NULL) != nb_common)
+      {
+        std::cerr << "ERROR: Kernel " << candidates[k].name << " does not find the correct intersection." << std::endl;
+        std::terminate();
+      }
+
+      // Times the kernels.
+      double timings[2];
+      int checksum = 0;
+      for(int c(0); c<2; ++c)
+      {
+        pgl::intersection_kernel_t::function_t function = (c == 0) ? candidates[k].intersect : candidates[k].count;
+        std::clock_t start = std::clock();
+        for(int r(0); r<nb_repetitions; ++r)
+        {
+          checksum += function(&a[0], small_size, &b[0], large_size, &out[0]);
+        }
+        timings[c] = 1e9 * (std::clock() - start) / CLOCKS_PER_SEC / nb_repetitions;
+      }
+      if(checksum != 2 * nb_repetitions * nb_common)
+      {
+        std::terminate();
+      }
+
+      std::cout << std::setw(8) << ratio << " " << std::setw(10) << candidates[k].name << " ";
+      std::cout << std::setw(15) << std::fixed << std::setprecision(0) << timings[0] << " ";
+      std::cout << std::setw(15) << std::fixed << std::setprecision(0) << timings[1] << std::endl;
+    }
+  }
+
+  return 0;
+ }
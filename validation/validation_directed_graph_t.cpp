@@ -3,6 +3,9 @@
  *  This code generates the text files used to validate the directed_graph_t
  *    class of the PGL to analyze the structure of directed, unweighted and
  *    simple graph.
+ *    It also verifies that the metrics kept up to date incrementally (see
+ *    enable_live_metrics) agree with a full recompute, and that the graph with
+ *    64-bit edge offsets (large_directed_graph_t) yields the same properties.
  *
  *  Compilation: g++ -O3 validation_directed_graph_t.cpp
  *
@@ -30,13 +33,89 @@
 
 
  // Standard template library
+ #include <cmath>
  #include <iomanip>
  #include <fstream>
+ #include <sstream>
  #include <string>
  // Portable graph library
  #include "../src/directed_graph_t.hpp"
 
 
+ // Compiles every method of the graph with 64-bit edge offsets (see large_directed_graph_t).
+ template class pgl::basic_directed_graph_t<int64_t>;
+
+
+ // Verifies that two values agree (up to rounding errors) and terminates otherwise.
+ void check_same_value(const std::string& what, double live_value, double recomputed_value)
+ {
+  bool both_nan = (live_value != live_value) && (recomputed_value != recomputed_value);
+  if(!both_nan && !(std::fabs(live_value - recomputed_value) <= 1e-9 * std::max(1.0, std::fabs(recomputed_value))))
+  {
+    std::cerr << "ERROR: " << what << " kept up to date (" << live_value << ") differs from its recomputed value (" << recomputed_value << ")." << std::endl;
+    std::terminate();
+  }
+ }
+
+
+ // Applies the same fixed sequence of insertions and removals of edges (and of new vertices).
+ void modify_graph(pgl::directed_graph_t& g)
+ {
+  // New vertices, connected to the graph by the random edges below.
+  g.add_vertex("live_vertex_1");
+  g.add_vertex("live_vertex_2");
+  // Random pairs of vertices (linear congruential generator, such that the sequence does not
+  //   depend on the platform). Existing edges are removed, missing ones are added.
+  uint64_t state = 12345;
+  int nb_vertices = g.g_prop["nb_vertices"];
+  for(int i(0); i<300; ++i)
+  {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int v1 = (state >> 33) % nb_vertices;
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    int v2 = (state >> 33) % nb_vertices;
+    if(g.has_edge(v1, v2))
+    {
+      g.remove_edge(v1, v2);
+    }
+    else
+    {
+      g.add_edge(v1, v2);
+    }
+  }
+ }
+
+
+ // Identifies the vertices of every triangle by their name.
+ std::set< std::set<std::string> > name_triangles(pgl::directed_graph_t& g)
+ {
+  std::set< std::set<std::string> > triangles;
+  std::set<std::string> triangles_vertices;
+  g.build_ID2Name();
+  for(std::size_t t(0), tt(g.triangles.size()); t<tt; ++t)
+  {
+    triangles_vertices.clear();
+    for(int i(0); i<3; ++i)
+    {
+      triangles_vertices.insert(g.ID2Name[g.triangles[t][i]]);
+    }
+    triangles.insert(triangles_vertices);
+  }
+  return triangles;
+ }
+
+
+ // Reads the whole content of a file.
+ std::string read_file(const std::string& filename)
+ {
+  std::ifstream file(filename.c_str());
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+ }
+
+
+
  int main(int argc, char const *argv[])
  {
   // Name of the file containing the edgelist.
@@ -117,7 +196,7 @@
   std::set<std::string>::iterator triangles_vertices_it, triangles_vertices_end;
   std::set< std::set<std::string> > triangles;
   std::set< std::set<std::string> >::iterator triangles_it, triangles_end;
-  for(int t(0), tt(g.g_prop["nb_triangles"]), v0, v1, v2; t<tt; ++t)
+  for(int64_t t(0), tt(g.g_prop["nb_triangles"]); t<tt; ++t)
   {
     // Identifies the vertices and sorts them.
     triangles_vertices.clear();
@@ -169,6 +248,147 @@
   triangle_spect_file.close();
 
 
+  // Verifies that the metrics kept up to date by the incremental mode agree with a full recompute.
+  pgl::directed_graph_t live_g(edgelist_filename);
+  live_g.enable_live_metrics();
+  modify_graph(live_g);
+  pgl::directed_graph_t recomputed_g(edgelist_filename);
+  modify_graph(recomputed_g);
+  recomputed_g.compute_degrees();
+  recomputed_g.compute_reciprocity();
+  recomputed_g.survey_triangles(false, true);
+  std::string s[] = {"nb_vertices", "nb_edges", "density", "nb_reciprocal_edges", "reciprocity_ratio", "reciprocity_stat", "nb_triangles", "undir_global_clust"};
+  for(int i(0); i<8; ++i)
+  {
+    check_same_value(s[i], live_g.g_prop[s[i]], recomputed_g.g_prop[s[i]]);
+  }
+  if(live_g.triangle_spect != recomputed_g.triangle_spect)
+  {
+    std::cerr << "ERROR: The triangle spectrum kept up to date differs from its recomputed value." << std::endl;
+    std::terminate();
+  }
+  std::string c[] = {"in-degree", "out-degree", "reciprocal_degree", "reciprocity_jaccard", "reciprocity_ratio", "undir_local_clust"};
+  for(int i(0), nb_vertices(recomputed_g.g_prop["nb_vertices"]); i<6; ++i)
+  {
+    for(int v(0); v<nb_vertices; ++v)
+    {
+      check_same_value(c[i], live_g.v_prop[c[i]][v], recomputed_g.v_prop[c[i]][v]);
+    }
+  }
+
+
+  // Verifies that the graph with 64-bit edge offsets yields the same properties.
+  pgl::large_directed_graph_t large_g(edgelist_filename);
+  large_g.compute_reciprocity();
+  large_g.survey_triangles(false, true);
+  for(int i(0); i<8; ++i)
+  {
+    check_same_value(s[i] + " with 64-bit edge offsets", large_g.g_prop[s[i]], g.g_prop[s[i]]);
+  }
+  if(large_g.triangle_spect != g.triangle_spect)
+  {
+    std::cerr << "ERROR: The triangle spectrum with 64-bit edge offsets differs." << std::endl;
+    std::terminate();
+  }
+
+
+  // Verifies that the compressed adjacency list (with the edgelist released) and the index built
+  //   afterwards, with its Bloom filter, answer the same edge queries and yield the same properties.
+  pgl::directed_graph_t compressed_g(edgelist_filename);
+  compressed_g.compress_adjacency_list(true);
+  compressed_g.compute_reciprocity();
+  compressed_g.survey_triangles(false, true);
+  for(int i(0); i<8; ++i)
+  {
+    check_same_value(s[i] + " with the compressed adjacency list", compressed_g.g_prop[s[i]], g.g_prop[s[i]]);
+  }
+  if(compressed_g.triangle_spect != g.triangle_spect)
+  {
+    std::cerr << "ERROR: The triangle spectrum with the compressed adjacency list differs." << std::endl;
+    std::terminate();
+  }
+  compressed_g.compress_adjacency_list(true);
+  for(int pass(0); pass<2; ++pass)
+  {
+    if(pass == 1)
+    {
+      compressed_g.build_edge_index(true);
+    }
+    for(pgl::directed_graph_t::edgelist_iterator it = g.edgelist_begin(), end = g.edgelist_end(); it!=end; ++it)
+    {
+      if(!compressed_g.has_edge(it->first, it->second))
+      {
+        std::cerr << "ERROR: An edge is missing from the " << ((pass == 0) ? "compressed adjacency list." : "edge index.") << std::endl;
+        std::terminate();
+      }
+    }
+    for(int v1(0), nb_vertices(g.g_prop["nb_vertices"]); v1<nb_vertices; v1 += 7)
+    {
+      for(int v2(0); v2<nb_vertices; v2 += 3)
+      {
+        if(compressed_g.has_edge(v1, v2) != g.has_edge(v1, v2))
+        {
+          std::cerr << "ERROR: The " << ((pass == 0) ? "compressed adjacency list" : "edge index") << " disagrees on the edge (" << v1 << ", " << v2 << ")." << std::endl;
+          std::terminate();
+        }
+      }
+    }
+  }
+
+
+  // Verifies that a graph saved into a binary snapshot and opened again (with its checksum
+  //   verified) has the same vertices and yields the same properties.
+  g.save_binary_snapshot("validation_snapshot_pgl.bin");
+  pgl::directed_graph_t snapshot_g;
+  snapshot_g.open_binary_snapshot("validation_snapshot_pgl.bin", true);
+  g.build_ID2Name();
+  snapshot_g.build_ID2Name();
+  for(int v(0), nb_vertices(g.g_prop["nb_vertices"]); v<nb_vertices; ++v)
+  {
+    if(snapshot_g.ID2Name[v] != g.ID2Name[v].str())
+    {
+      std::cerr << "ERROR: The name of vertex " << v << " differs in the binary snapshot." << std::endl;
+      std::terminate();
+    }
+  }
+  snapshot_g.compute_reciprocity();
+  snapshot_g.survey_triangles(false, true);
+  for(int i(0); i<8; ++i)
+  {
+    check_same_value(s[i] + " from the binary snapshot", snapshot_g.g_prop[s[i]], g.g_prop[s[i]]);
+  }
+  if(snapshot_g.triangle_spect != g.triangle_spect)
+  {
+    std::cerr << "ERROR: The triangle spectrum from the binary snapshot differs." << std::endl;
+    std::terminate();
+  }
+
+
+  // Verifies that the outputs identifying the vertices by name are unchanged after the vertices
+  //   have been renumbered by each of the orderings.
+  pgl::directed_graph_t::vertex_order_t o[] = {pgl::directed_graph_t::order_by_degree, pgl::directed_graph_t::order_by_bfs, pgl::directed_graph_t::order_by_rcm, pgl::directed_graph_t::order_by_gorder};
+  std::string v_prop_content = read_file("validation_v_prop_pgl.dat");
+  for(int i(0); i<4; ++i)
+  {
+    pgl::directed_graph_t reordered_g(g);
+    reordered_g.reorder_vertices(o[i]);
+    reordered_g.save_vertices_properties("validation_v_prop_reordered_pgl.dat", props);
+    if(read_file("validation_v_prop_reordered_pgl.dat") != v_prop_content)
+    {
+      std::cerr << "ERROR: The vertex properties differ after reordering the vertices (order " << i << ")." << std::endl;
+      std::terminate();
+    }
+    if(name_triangles(reordered_g) != triangles)
+    {
+      std::cerr << "ERROR: The triangles differ after reordering the vertices (order " << i << ")." << std::endl;
+      std::terminate();
+    }
+    if(reordered_g.triangle_spect != g.triangle_spect)
+    {
+      std::cerr << "ERROR: The triangle spectrum differs after reordering the vertices (order " << i << ")." << std::endl;
+      std::terminate();
+    }
+  }
 
 
   return 0;